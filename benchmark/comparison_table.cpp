@@ -1,4 +1,5 @@
-/* Comparison table for several configurations of boost::bloom::filter.
+/* Comparison table for several configurations of boost::bloom::filter,
+ * and of boost::bloom::static_filter against boost::bloom::filter.
  * 
  * Copyright 2025 Joaquin M Lopez Munoz.
  * Distributed under the Boost Software License, Version 1.0.
@@ -54,10 +55,13 @@ void resume_timing()
 }
 
 #include <boost/bloom/block.hpp>
+#include <boost/bloom/fast_block.hpp>
 #include <boost/bloom/fast_multiblock32.hpp>
 #include <boost/bloom/fast_multiblock64.hpp>
 #include <boost/bloom/filter.hpp>
 #include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/static_filter.hpp>
+#include <boost/bloom/thread_executor.hpp>
 #include <boost/core/detail/splitmix64.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
@@ -66,6 +70,7 @@ void resume_timing()
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -76,49 +81,89 @@ struct unordered_flat_set_filter
 
   unordered_flat_set_filter(std::size_t){}
   void insert(const T& x){s.insert(x);}
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last){s.insert(first,last);}
   bool may_contain(const T& x){return s.contains(x);}
 
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain(
+    InputIterator first,InputIterator last,OutputIterator res)
+  {
+    while(first!=last)*res++=may_contain(*first++);
+    return res;
+  }
+
   boost::unordered_flat_set<T> s;
 };
 
+/* output iterator accumulating the number of positive lookups */
+
+struct positive_counter
+{
+  using iterator_category=std::output_iterator_tag;
+  using value_type=void;
+  using difference_type=std::ptrdiff_t;
+  using pointer=void;
+  using reference=void;
+
+  positive_counter& operator*(){return *this;}
+  positive_counter& operator++(){return *this;}
+  positive_counter& operator++(int){return *this;}
+  positive_counter& operator=(bool b){*res+=b;return *this;}
+
+  std::size_t* res;
+};
+
 static std::size_t num_elements;
 
 struct test_results
 {
   double fpr;                      /* % */
   double insertion_time;           /* ns per element */
+  double bulk_insertion_time;      /* ns per element */
   double successful_lookup_time;   /* ns per element */
   double unsuccessful_lookup_time; /* ns per element */
+  double bulk_successful_lookup_time;   /* ns per element */
+  double bulk_unsuccessful_lookup_time; /* ns per element */
 };
 
-template<typename Filter>
-test_results test(std::size_t c)
-{
-  using value_type=typename Filter::value_type;
+/* num_elements distinct values to insert and num_elements other values
+ * not inserted
+ */
 
-  std::vector<value_type> data_in,data_out;
-  {
-    boost::detail::splitmix64             rng;
-    boost::unordered_flat_set<value_type> unique;
-    for(std::size_t i=0;i<num_elements;++i){
-      for(;;){
-        auto x=value_type(rng());
-        if(unique.insert(x).second){
-          data_in.push_back(x);
-          break;
-        }
+template<typename T>
+void make_data(std::vector<T>& data_in,std::vector<T>& data_out)
+{
+  boost::detail::splitmix64    rng;
+  boost::unordered_flat_set<T> unique;
+  for(std::size_t i=0;i<num_elements;++i){
+    for(;;){
+      auto x=T(rng());
+      if(unique.insert(x).second){
+        data_in.push_back(x);
+        break;
       }
     }
-    for(std::size_t i=0;i<num_elements;++i){
-      for(;;){
-        auto x=value_type(rng());
-        if(!unique.contains(x)){
-          data_out.push_back(x);
-          break;
-        }
+  }
+  for(std::size_t i=0;i<num_elements;++i){
+    for(;;){
+      auto x=T(rng());
+      if(!unique.contains(x)){
+        data_out.push_back(x);
+        break;
       }
     }
   }
+}
+
+template<typename Filter>
+test_results test(std::size_t c)
+{
+  using value_type=typename Filter::value_type;
+
+  std::vector<value_type> data_in,data_out;
+  make_data(data_in,data_out);
 
   double fpr=0.0;
   {
@@ -145,8 +190,26 @@ test_results test(std::size_t c)
     insertion_time=t/num_elements*1E9;
   }
 
+  double bulk_insertion_time=0.0;
+  {
+    double t=measure([&]{
+      pause_timing();
+      {
+        Filter f(c*num_elements);
+        resume_timing();
+        f.insert(data_in.begin(),data_in.end());
+        pause_timing();
+      }
+      resume_timing();
+      return 0;
+    });
+    bulk_insertion_time=t/num_elements*1E9;
+  }
+
   double successful_lookup_time=0.0;
   double unsuccessful_lookup_time=0.0;
+  double bulk_successful_lookup_time=0.0;
+  double bulk_unsuccessful_lookup_time=0.0;
   {
     Filter f(c*num_elements);
     for(const auto& x:data_in)f.insert(x);
@@ -162,9 +225,113 @@ test_results test(std::size_t c)
       return res;
     });
     unsuccessful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(data_in.begin(),data_in.end(),positive_counter{&res});
+      return res;
+    });
+    bulk_successful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(data_out.begin(),data_out.end(),positive_counter{&res});
+      return res;
+    });
+    bulk_unsuccessful_lookup_time=t/num_elements*1E9;
   }
 
-  return {fpr,insertion_time,successful_lookup_time,unsuccessful_lookup_time};
+  return {
+    fpr,insertion_time,bulk_insertion_time,successful_lookup_time,unsuccessful_lookup_time,
+    bulk_successful_lookup_time,bulk_unsuccessful_lookup_time};
+}
+
+/* static_filter is built from the whole set of elements: construction
+ * time replaces insertion time, and construction with a thread_executor
+ * replaces bulk insertion time
+ */
+
+template<typename Filter>
+test_results test_static(double& c)
+{
+  using value_type=typename Filter::value_type;
+
+  std::vector<value_type> data_in,data_out;
+  make_data(data_in,data_out);
+
+  double fpr=0.0;
+  {
+    std::size_t res=0;
+    Filter f(data_in.begin(),data_in.end());
+    for(const auto& x:data_out)res+=f.may_contain(x);
+    fpr=(double)res*100/num_elements;
+    c=(double)f.capacity()/num_elements;
+  }
+
+  double insertion_time=0.0;
+  {
+    double t=measure([&]{
+      std::size_t res;
+      {
+        Filter f(data_in.begin(),data_in.end());
+        res=f.capacity();
+        pause_timing();
+      }
+      resume_timing();
+      return res;
+    });
+    insertion_time=t/num_elements*1E9;
+  }
+
+  double bulk_insertion_time=0.0;
+  {
+    boost::bloom::thread_executor ex;
+    double t=measure([&]{
+      std::size_t res;
+      {
+        Filter f(ex,data_in.begin(),data_in.end());
+        res=f.capacity();
+        pause_timing();
+      }
+      resume_timing();
+      return res;
+    });
+    bulk_insertion_time=t/num_elements*1E9;
+  }
+
+  double successful_lookup_time=0.0;
+  double unsuccessful_lookup_time=0.0;
+  double bulk_successful_lookup_time=0.0;
+  double bulk_unsuccessful_lookup_time=0.0;
+  {
+    Filter f(data_in.begin(),data_in.end());
+    double t=measure([&]{
+      std::size_t res=0;
+      for(const auto& x:data_in)res+=f.may_contain(x);
+      return res;
+    });
+    successful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      for(const auto& x:data_out)res+=f.may_contain(x);
+      return res;
+    });
+    unsuccessful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(data_in.begin(),data_in.end(),positive_counter{&res});
+      return res;
+    });
+    bulk_successful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(data_out.begin(),data_out.end(),positive_counter{&res});
+      return res;
+    });
+    bulk_unsuccessful_lookup_time=t/num_elements*1E9;
+  }
+
+  return {
+    fpr,insertion_time,bulk_insertion_time,successful_lookup_time,unsuccessful_lookup_time,
+    bulk_successful_lookup_time,bulk_unsuccessful_lookup_time};
 }
 
 struct print_double
@@ -184,6 +351,18 @@ struct print_double
   int    precision;
 };
 
+void print_cells(const test_results& res)
+{
+  std::cout<<
+    "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_insertion_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_successful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n";
+}
+
 template<typename Filters> void row(std::size_t c)
 {
   std::cout<<
@@ -196,17 +375,39 @@ template<typename Filters> void row(std::size_t c)
     using filter=typename decltype(i)::type;
     auto res=test<filter>(c);
     std::cout<<
-      "    <td align=\"center\">"<<filter::k*filter::subfilter::k<<"</td>\n"
-      "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
-      "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
-      "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
-      "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n";
+      "    <td align=\"center\">"<<filter::k*filter::subfilter::k<<"</td>\n";
+    print_cells(res);
   });
 
   std::cout<<
     "  </tr>\n";
 }
 
+/* StaticFilter against Filter with (roughly) the same number of bits per
+ * element
+ */
+
+template<typename StaticFilter,typename Filter> void static_row()
+{
+  double c=0.0;
+  auto   res=test_static<StaticFilter>(c);
+  auto   c2=(std::size_t)(c+0.5);
+
+  std::cout<<
+    "  <tr>\n"
+    "    <td align=\"center\">"<<StaticFilter::fingerprint_bits<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(c)<<"</td>\n";
+  print_cells(res);
+
+  res=test<Filter>(c2);
+  std::cout<<
+    "    <td align=\"center\">"<<c2<<"</td>\n"
+    "    <td align=\"center\">"<<Filter::k*Filter::subfilter::k<<"</td>\n";
+  print_cells(res);
+  std::cout<<
+    "  </tr>\n";
+}
+
 using namespace boost::bloom;
 
 template<std::size_t K1,std::size_t K2,std::size_t K3>
@@ -230,6 +431,13 @@ using filters3=boost::mp11::mp_list<
   filter<int,1,fast_multiblock64<K3>,1>
 >;
 
+template<std::size_t K1,std::size_t K2,std::size_t K3>
+using filters4=boost::mp11::mp_list<
+  filter<int,1,fast_block<K1>>,
+  filter<int,1,fast_block<K2>,1>,
+  filter<int,1,fast_block<K3,512>>
+>;
+
 int main(int argc,char* argv[])
 {
   if(argc<2){
@@ -249,16 +457,22 @@ int main(int argc,char* argv[])
   auto res=test<unordered_flat_set_filter<int>>(0);
   std::cout<<
     "<table>\n"
-    "  <tr><th colspan=\"3\"><code>boost::unordered_flat_set</code></tr>\n"
+    "  <tr><th colspan=\"6\"><code>boost::unordered_flat_set</code></tr>\n"
     "  <tr>\n"
     "    <th>insertion</th>\n"
+    "    <th>bulk<br/>insertion</th>\n"
     "    <th>successful<br/>lookup</th>\n"
     "    <th>unsuccessful<br/>lookup</th>\n"
+    "    <th>successful<br/>bulk lookup</th>\n"
+    "    <th>unsuccessful<br/>bulk lookup</th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_insertion_time)<<"</td>\n"
     "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
     "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_successful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n"
     "  </tr>\n"
     "</table>\n";
 
@@ -268,16 +482,19 @@ int main(int argc,char* argv[])
     "    <th>K</th>\n"
     "    <th>FPR<br/>[%]</th>\n"
     "    <th>ins.</th>\n"
+    "    <th>bulk<br/>ins.</th>\n"
     "    <th>succ.<br/>lkp.</th>\n"
-    "    <th>uns.<br/>lkp.</th>\n";
+    "    <th>uns.<br/>lkp.</th>\n"
+    "    <th>succ.<br/>bulk<br/>lkp.</th>\n"
+    "    <th>uns.<br/>bulk<br/>lkp.</th>\n";
 
   std::cout<<
     "<table>\n"
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;K></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,block&lt;uint64_t,K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,block&lt;uint64_t,K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;K></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,block&lt;uint64_t,K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,block&lt;uint64_t,K>,1></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -294,9 +511,9 @@ int main(int argc,char* argv[])
   std::cout<<
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,multiblock&lt;uint64_t,K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,multiblock&lt;uint64_t,K>,1></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,fast_multiblock32&lt;K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,multiblock&lt;uint64_t,K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,multiblock&lt;uint64_t,K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_multiblock32&lt;K>></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -313,9 +530,9 @@ int main(int argc,char* argv[])
   std::cout<<
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,fast_multiblock32&lt;K>,1></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,fast_multiblock64&lt;K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;1,fast_multiblock64&lt;K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_multiblock32&lt;K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_multiblock64&lt;K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_multiblock64&lt;K>,1></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -329,5 +546,52 @@ int main(int argc,char* argv[])
   row<filters3<11, 11, 11>>(16);
   row<filters3<13, 13, 14>>(20);
 
+  std::cout<<
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_block&lt;K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_block&lt;K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;1,fast_block&lt;K,512>></code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    subheader<<
+    subheader<<
+    "  </tr>\n";
+
+  row<filters4< 5,  5,  5>>( 8);
+  row<filters4< 7,  8,  8>>(12);
+  row<filters4< 9, 10, 10>>(16);
+  row<filters4<10, 11, 11>>(20);
+
+  std::cout<<"</table>\n";
+
+  /* static_filter table */
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"8\"><code>static_filter&lt;F></code></th>\n"
+    "    <th colspan=\"9\"><code>filter&lt;1,fast_multiblock32&lt;K>></code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>F</th>\n"
+    "    <th>c</th>\n"
+    "    <th>FPR<br/>[%]</th>\n"
+    "    <th>constr.</th>\n"
+    "    <th>parallel<br/>constr.</th>\n"
+    "    <th>succ.<br/>lkp.</th>\n"
+    "    <th>uns.<br/>lkp.</th>\n"
+    "    <th>succ.<br/>bulk<br/>lkp.</th>\n"
+    "    <th>uns.<br/>bulk<br/>lkp.</th>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    "  </tr>\n";
+
+  static_row<static_filter<int, 8>,filter<int,1,fast_multiblock32< 6>>>();
+  static_row<static_filter<int,16>,filter<int,1,fast_multiblock32<12>>>();
+
   std::cout<<"</table>\n";
 }
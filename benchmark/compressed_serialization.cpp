@@ -0,0 +1,129 @@
+/* Size and encoding/decoding speed of compressed serialization of
+ * boost::bloom::filter for several fill ratios.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=7;
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    auto                   t1=high_resolution_clock::now();
+    volatile decltype(f()) res=f(); /* to avoid optimizing f() away */
+    (void)res;
+    auto                   t2=high_resolution_clock::now();
+    trials[i]=duration_cast<duration<double>>(t2-t1).count();
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/serialization.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using filter=boost::bloom::filter<
+  boost::uint64_t,1,boost::bloom::block<boost::uint64_t,7>>;
+
+/* Times are in GB/s of the uncompressed array. load includes resetting the
+ * destination filter, merge ORs into an existing filter.
+ */
+
+void row(std::size_t mb,double fill)
+{
+  using boost::bloom::serialization_format;
+
+  filter f(mb*8*1024*1024);
+  {
+    /* filter with approximately the given fill ratio */
+    boost::detail::splitmix64 rng;
+    auto                      n=(std::size_t)(
+      -std::log(1.0-fill)*(double)f.capacity()/7);
+    for(std::size_t i=0;i<n;++i)f.insert(rng());
+  }
+
+  std::vector<unsigned char> buf;
+  boost::bloom::save(f,buf,serialization_format::compressed);
+
+  double gb=(double)f.array().size()/1E9;
+  double t_save=measure([&]{
+    std::vector<unsigned char> buf2;
+    boost::bloom::save(f,buf2,serialization_format::compressed);
+    return buf2.size();
+  });
+  filter f2;
+  double t_load=measure([&]{
+    boost::bloom::load(f2,buf.data(),buf.size());
+    return f2.capacity();
+  });
+  filter f3(f.capacity());
+  double t_merge=measure([&]{
+    boost::bloom::merge(f3,buf.data(),buf.size());
+    return f3.capacity();
+  });
+
+  std::cout<<
+    "  <tr>\n"
+    "    <td align=\"right\">"<<mb<<"</td>\n"
+    "    <td align=\"right\">"<<std::fixed<<std::setprecision(3)<<
+    f.fill_ratio()<<"</td>\n"
+    "    <td align=\"right\">"<<
+    (double)buf.size()/f.array().size()<<"</td>\n"
+    "    <td align=\"right\">"<<std::setprecision(2)<<gb/t_save<<"</td>\n"
+    "    <td align=\"right\">"<<gb/t_load<<"</td>\n"
+    "    <td align=\"right\">"<<gb/t_merge<<"</td>\n"
+    "  </tr>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  std::size_t mb=64;
+  if(argc>1){
+    try{
+      mb=std::stoul(argv[1]);
+    }
+    catch(...){
+      std::cerr<<"wrong arg\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th>size<br/>[MB]</th>\n"
+    "    <th>fill<br/>ratio</th>\n"
+    "    <th>compression<br/>ratio</th>\n"
+    "    <th>save<br/>[GB/s]</th>\n"
+    "    <th>load<br/>[GB/s]</th>\n"
+    "    <th>merge<br/>[GB/s]</th>\n"
+    "  </tr>\n";
+  for(double fill:{0.0,0.001,0.005,0.01,0.02,0.05,0.1,0.2,0.5}){
+    row(mb,fill);
+  }
+  std::cout<<"</table>\n";
+}
@@ -0,0 +1,218 @@
+/* Scalability of boost::bloom::concurrent_filter with the number of threads.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=7;
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    auto t1=high_resolution_clock::now();
+    f();
+    auto t2=high_resolution_clock::now();
+    trials[i]=duration_cast<duration<double>>(t2-t1).count();
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/thread_executor.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::size_t num_elements;
+static std::size_t max_num_threads;
+static std::vector<boost::uint64_t> data;
+
+/* Elements are evenly split among num_threads threads, which insert them
+ * in bulk (bulk==true) or one by one into a filter of capacity
+ * c*num_elements, or look them up in a filter containing half of them.
+ * Times are in ns per element (wall time, so ideal scaling with the number
+ * of threads would show as decreasing times).
+ */
+
+template<typename Filter>
+double insertion_time(std::size_t c,std::size_t num_threads,bool bulk)
+{
+  std::unique_ptr<Filter> pf;
+  double t=measure([&]{
+    pf.reset(new Filter(c*num_elements));
+    std::vector<std::thread> threads;
+    for(std::size_t i=0;i<num_threads;++i){
+      threads.emplace_back([&,i]{
+        auto first=data.begin()+i*num_elements/num_threads,
+             last=data.begin()+(i+1)*num_elements/num_threads;
+        if(bulk)pf->insert(first,last);
+        else for(;first!=last;++first)pf->insert(*first);
+      });
+    }
+    for(auto& th:threads)th.join();
+  });
+  return t/num_elements*1E9;
+}
+
+/* parallel bulk insertion with a thread_executor of num_threads threads */
+
+template<typename Filter>
+double parallel_insertion_time(std::size_t c,std::size_t num_threads)
+{
+  boost::bloom::thread_executor ex(num_threads);
+  std::unique_ptr<Filter>       pf;
+  double t=measure([&]{
+    pf.reset(new Filter(c*num_elements));
+    pf->insert(ex,data.begin(),data.end());
+  });
+  return t/num_elements*1E9;
+}
+
+template<typename Filter>
+double lookup_time(std::size_t c,std::size_t num_threads)
+{
+  Filter f(c*num_elements);
+  f.insert(data.begin(),data.begin()+num_elements/2);
+  double t=measure([&]{
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> res(num_threads);
+    for(std::size_t i=0;i<num_threads;++i){
+      threads.emplace_back([&,i]{
+        auto first=data.begin()+i*num_elements/num_threads,
+             last=data.begin()+(i+1)*num_elements/num_threads;
+        for(;first!=last;++first)res[i]+=f.may_contain(*first);
+      });
+    }
+    for(auto& th:threads)th.join();
+    volatile std::size_t sum=
+      std::accumulate(res.begin(),res.end(),std::size_t(0));
+    (void)sum;
+  });
+  return t/num_elements*1E9;
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+template<typename Filter,typename ConcurrentFilter>
+void table(const char* name,std::size_t c)
+{
+  std::cout<<
+    "<table>\n"
+    "  <tr><th colspan=\"5\"><code>"<<name<<"</code>, c="<<c<<"</tr>\n"
+    "  <tr>\n"
+    "    <th>threads</th>\n"
+    "    <th>ins.</th>\n"
+    "    <th>bulk<br/>ins.</th>\n"
+    "    <th>lkp.</th>\n"
+    "    <th>par.<br/>ins.</th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <td align=\"center\">1 (<code>filter</code>)</td>\n"
+    "    <td align=\"right\">"<<
+    print_double(insertion_time<Filter>(c,1,false))<<"</td>\n"
+    "    <td align=\"right\">"<<
+    print_double(insertion_time<Filter>(c,1,true))<<"</td>\n"
+    "    <td align=\"right\">"<<
+    print_double(lookup_time<Filter>(c,1))<<"</td>\n"
+    "    <td></td>\n"
+    "  </tr>\n";
+  for(std::size_t n=1;n<=max_num_threads;n*=2){
+    std::cout<<
+      "  <tr>\n"
+      "    <td align=\"center\">"<<n<<"</td>\n"
+      "    <td align=\"right\">"<<
+      print_double(insertion_time<ConcurrentFilter>(c,n,false))<<"</td>\n"
+      "    <td align=\"right\">"<<
+      print_double(insertion_time<ConcurrentFilter>(c,n,true))<<"</td>\n"
+      "    <td align=\"right\">"<<
+      print_double(lookup_time<ConcurrentFilter>(c,n))<<"</td>\n"
+      "    <td align=\"right\">"<<
+      print_double(parallel_insertion_time<Filter>(c,n))<<"</td>\n"
+      "  </tr>\n";
+    if(n<max_num_threads&&2*n>max_num_threads)n=max_num_threads/2;
+  }
+  std::cout<<"</table>\n";
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements [and max number of threads]\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+    max_num_threads=argc>2?
+      std::stoul(argv[2]):
+      (std::max)(std::thread::hardware_concurrency(),1u);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(rng());
+
+  using block_type=block<boost::uint64_t,7>;
+  using multiblock_type=multiblock<boost::uint64_t,8>;
+  using fast_multiblock_type=fast_multiblock32<8>;
+
+  table<
+    filter<boost::uint64_t,1,block_type>,
+    concurrent_filter<boost::uint64_t,1,block_type>
+  >("filter&lt;1,block&lt;uint64_t,7>>",12);
+  table<
+    filter<boost::uint64_t,1,multiblock_type>,
+    concurrent_filter<boost::uint64_t,1,multiblock_type>
+  >("filter&lt;1,multiblock&lt;uint64_t,8>>",12);
+  table<
+    filter<boost::uint64_t,1,fast_multiblock_type>,
+    concurrent_filter<boost::uint64_t,1,fast_multiblock_type>
+  >("filter&lt;1,fast_multiblock32&lt;8>>",12);
+}
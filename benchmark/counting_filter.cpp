@@ -0,0 +1,243 @@
+/* Performance of boost::bloom::counting_filter with 4- and 8-bit counters
+ * compared with boost::bloom::filter.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start,measure_pause;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+void pause_timing()
+{
+  measure_pause=std::chrono::high_resolution_clock::now();
+}
+
+void resume_timing()
+{
+  measure_start+=std::chrono::high_resolution_clock::now()-measure_pause;
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/counting_filter.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t num_elements;
+
+struct test_results
+{
+  double insertion_time;           /* ns per element */
+  double successful_lookup_time;   /* ns per element */
+  double unsuccessful_lookup_time; /* ns per element */
+  double erasure_time;             /* ns per element */
+};
+
+template<typename Filter>
+struct erase_all
+{
+  static constexpr bool supported=false;
+
+  static void apply(Filter&,const std::vector<int>&){}
+};
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,std::size_t C,
+  typename H,typename A,typename HS
+>
+struct erase_all<boost::bloom::counting_filter<T,K,S,B,C,H,A,HS>>
+{
+  static constexpr bool supported=true;
+
+  template<typename Filter>
+  static void apply(Filter& f,const std::vector<int>& data)
+  {
+    for(const auto& x:data)f.erase(x);
+  }
+};
+
+template<typename Filter>
+test_results test(std::size_t c)
+{
+  std::vector<int> data_in,data_out;
+  for(std::size_t i=0;i<num_elements;++i){
+    data_in.push_back((int)i);
+    data_out.push_back((int)(i+num_elements));
+  }
+
+  double insertion_time=measure([&]{
+    pause_timing();
+    {
+      Filter f(c*num_elements);
+      resume_timing();
+      for(const auto& x:data_in)f.insert(x);
+      pause_timing();
+    }
+    resume_timing();
+    return 0;
+  })/num_elements*1E9;
+
+  Filter f(c*num_elements);
+  for(const auto& x:data_in)f.insert(x);
+
+  double successful_lookup_time=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_in)res+=f.may_contain(x);
+    return res;
+  })/num_elements*1E9;
+  double unsuccessful_lookup_time=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_out)res+=f.may_contain(x);
+    return res;
+  })/num_elements*1E9;
+  double erasure_time=measure([&]{
+    pause_timing();
+    {
+      Filter f2(f);
+      resume_timing();
+      erase_all<Filter>::apply(f2,data_in);
+      pause_timing();
+    }
+    resume_timing();
+    return 0;
+  })/num_elements*1E9;
+
+  return {
+    insertion_time,successful_lookup_time,unsuccessful_lookup_time,
+    erasure_time};
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+using namespace boost::bloom;
+
+template<typename Filter>
+void cells(std::size_t c)
+{
+  auto res=test<Filter>(c);
+  std::cout<<
+    "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n";
+  if(erase_all<Filter>::supported){
+    std::cout<<
+      "    <td align=\"right\">"<<print_double(res.erasure_time)<<"</td>\n";
+  }
+}
+
+template<std::size_t K,typename Subfilter>
+void row(const char* name,std::size_t c)
+{
+  std::cout<<
+    "  <tr>\n"
+    "    <td><code>"<<name<<"</code></td>\n"
+    "    <td align=\"center\">"<<c<<"</td>\n";
+  cells<filter<int,K,Subfilter>>(c);
+  cells<counting_filter<int,K,Subfilter,0,4>>(c);
+  cells<counting_filter<int,K,Subfilter,0,8>>(c);
+  std::cout<<
+    "  </tr>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  auto subheader=
+    "    <th>ins.</th>\n"
+    "    <th>succ.<br/>lkp.</th>\n"
+    "    <th>uns.<br/>lkp.</th>\n";
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"3\"><code>filter</code></th>\n"
+    "    <th colspan=\"4\"><code>counting_filter</code> (4 bits)</th>\n"
+    "    <th colspan=\"4\"><code>counting_filter</code> (8 bits)</th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>filter</th>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    subheader<<"    <th>erase</th>\n"<<
+    subheader<<"    <th>erase</th>\n"<<
+    "  </tr>\n";
+
+  row< 6,block<unsigned char,1>>("filter&lt;int,6>",8);
+  row< 1,block<boost::uint64_t,7>>("filter&lt;int,1,block&lt;uint64_t,7>>",12);
+  row< 1,multiblock<boost::uint64_t,8>>(
+    "filter&lt;int,1,multiblock&lt;uint64_t,8>>",12);
+  row< 1,fast_multiblock32<8>>("filter&lt;int,1,fast_multiblock32&lt;8>>",12);
+
+  std::cout<<"</table>\n";
+}
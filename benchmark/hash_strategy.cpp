@@ -0,0 +1,269 @@
+/* Performance of boost::bloom::filter with the different hash strategies
+ * provided by the library.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start,measure_pause;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+void pause_timing()
+{
+  measure_pause=std::chrono::high_resolution_clock::now();
+}
+
+void resume_timing()
+{
+  measure_start+=std::chrono::high_resolution_clock::now()-measure_pause;
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/* output iterator accumulating the number of positive lookups */
+
+struct positive_counter
+{
+  using iterator_category=std::output_iterator_tag;
+  using value_type=void;
+  using difference_type=std::ptrdiff_t;
+  using pointer=void;
+  using reference=void;
+
+  positive_counter& operator*(){return *this;}
+  positive_counter& operator++(){return *this;}
+  positive_counter& operator++(int){return *this;}
+  positive_counter& operator=(bool b){*res+=b;return *this;}
+
+  std::size_t* res;
+};
+
+static std::size_t num_elements;
+
+struct test_results
+{
+  double capacity;                      /* bits per element */
+  double fpr;                           /* % */
+  double insertion_time;                /* ns per element */
+  double successful_lookup_time;        /* ns per element */
+  double unsuccessful_lookup_time;      /* ns per element */
+  double bulk_unsuccessful_lookup_time; /* ns per element */
+};
+
+/* elements are consecutive integers, which are cheap to hash, so that the
+ * cost of computing positions is not masked
+ */
+
+template<typename Filter>
+test_results test(std::size_t c)
+{
+  using value_type=typename Filter::value_type;
+
+  std::vector<value_type> data_in,data_out;
+  for(std::size_t i=0;i<num_elements;++i){
+    data_in.push_back((value_type)i);
+    data_out.push_back((value_type)(i+num_elements));
+  }
+
+  Filter f(c*num_elements);
+  for(const auto& x:data_in)f.insert(x);
+  double capacity=(double)f.capacity()/num_elements;
+
+  double fpr=0.0;
+  {
+    std::size_t res=0;
+    for(const auto& x:data_out)res+=f.may_contain(x);
+    fpr=(double)res*100/num_elements;
+  }
+
+  double insertion_time=0.0;
+  {
+    double t=measure([&]{
+      pause_timing();
+      {
+        Filter f2(c*num_elements);
+        resume_timing();
+        for(const auto& x:data_in)f2.insert(x);
+        pause_timing();
+      }
+      resume_timing();
+      return 0;
+    });
+    insertion_time=t/num_elements*1E9;
+  }
+
+  double t=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_in)res+=f.may_contain(x);
+    return res;
+  });
+  double successful_lookup_time=t/num_elements*1E9;
+  t=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_out)res+=f.may_contain(x);
+    return res;
+  });
+  double unsuccessful_lookup_time=t/num_elements*1E9;
+  t=measure([&]{
+    std::size_t res=0;
+    f.may_contain(data_out.begin(),data_out.end(),positive_counter{&res});
+    return res;
+  });
+  double bulk_unsuccessful_lookup_time=t/num_elements*1E9;
+
+  return {
+    capacity,fpr,insertion_time,successful_lookup_time,
+    unsuccessful_lookup_time,bulk_unsuccessful_lookup_time};
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+using namespace boost::bloom;
+
+using hash_strategies=boost::mp11::mp_list<
+  mcg_and_fastrange,mask_and_remix,fastrange32,double_hashing
+>;
+
+template<std::size_t K,typename Subfilter>
+void row(const char* name,std::size_t c)
+{
+  std::cout<<
+    "  <tr>\n"
+    "    <td><code>"<<name<<"</code></td>\n"
+    "    <td align=\"center\">"<<c<<"</td>\n";
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,hash_strategies>
+  >([&](auto i){
+    using hash_strategy=typename decltype(i)::type;
+    using filter=boost::bloom::filter<
+      int,K,Subfilter,0,boost::hash<int>,std::allocator<int>,hash_strategy>;
+
+    auto res=test<filter>(c);
+    std::cout<<
+      "    <td align=\"right\">"<<print_double(res.capacity,1)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n";
+  });
+
+  std::cout<<
+    "  </tr>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  auto subheader=
+    "    <th>m/n</th>\n"
+    "    <th>FPR<br/>[%]</th>\n"
+    "    <th>ins.</th>\n"
+    "    <th>succ.<br/>lkp.</th>\n"
+    "    <th>uns.<br/>lkp.</th>\n"
+    "    <th>uns.<br/>bulk<br/>lkp.</th>\n";
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"6\"><code>mcg_and_fastrange</code></th>\n"
+    "    <th colspan=\"6\"><code>mask_and_remix</code></th>\n"
+    "    <th colspan=\"6\"><code>fastrange32</code></th>\n"
+    "    <th colspan=\"6\"><code>double_hashing</code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>filter</th>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    subheader<<
+    subheader<<
+    subheader<<
+    "  </tr>\n";
+
+  row< 6,block<unsigned char,1>>("filter&lt;int,6>",8);
+  row<11,block<unsigned char,1>>("filter&lt;int,11>",16);
+  row<14,block<unsigned char,1>>("filter&lt;int,14>",20);
+  row<20,block<unsigned char,1>>("filter&lt;int,20>",28);
+  row< 3,block<boost::uint64_t,3>>("filter&lt;int,3,block&lt;uint64_t,3>>",12);
+  row< 1,fast_multiblock32<8>>("filter&lt;int,1,fast_multiblock32&lt;8>>",12);
+
+  std::cout<<"</table>\n";
+}
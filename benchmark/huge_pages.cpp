@@ -0,0 +1,137 @@
+/* Lookup times of boost::bloom::filter with 4 KB vs. 2 MB memory pages.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=7;
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    auto                   t1=high_resolution_clock::now();
+    volatile decltype(f()) res=f(); /* to avoid optimizing f() away */
+    (void)res;
+    auto                   t2=high_resolution_clock::now();
+    trials[i]=duration_cast<duration<double>>(t2-t1).count();
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/huge_page_allocator.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const std::size_t            num_lookups=10000000;
+static std::vector<boost::uint64_t> data;
+
+/* Independent lookups measure throughput (several cache/TLB misses in
+ * flight), whereas in dependent lookups the element looked up depends on
+ * the result of the previous lookup, so that latency is measured.
+ * Times are in ns per lookup.
+ */
+
+template<typename Allocator>
+void row(const char* name,std::size_t mb,const Allocator& al)
+{
+  using filter=boost::bloom::filter<
+    boost::uint64_t,1,boost::bloom::block<boost::uint64_t,7>,0,
+    boost::hash<boost::uint64_t>,Allocator>;
+
+  std::size_t m=mb*8*1024*1024;
+  filter      f(m,al);
+  {
+    /* random contents, half of the bits set on average */
+    boost::detail::splitmix64 rng;
+    for(auto& x:f.array())x=(unsigned char)rng();
+  }
+
+  double t_fill=measure([&]{
+    filter f2(m,al);
+    return f2.capacity();
+  });
+  double t_ind=measure([&]{
+    std::size_t res=0;
+    for(auto x:data)res+=f.may_contain(x);
+    return res;
+  });
+  double t_dep=measure([&]{
+    std::size_t res=0;
+    for(auto x:data)res+=f.may_contain(x+res);
+    return res;
+  });
+
+  std::cout<<
+    "  <tr>\n"
+    "    <td>"<<name<<"</td>\n"
+    "    <td align=\"right\">"<<mb<<"</td>\n"
+    "    <td align=\"right\">"<<std::fixed<<std::setprecision(2)<<
+    t_fill*1E3<<"</td>\n"
+    "    <td align=\"right\">"<<t_ind/data.size()*1E9<<"</td>\n"
+    "    <td align=\"right\">"<<t_dep/data.size()*1E9<<"</td>\n"
+    "  </tr>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  std::size_t max_mb=1024;
+  if(argc>1){
+    try{
+      max_mb=std::stoul(argv[1]);
+    }
+    catch(...){
+      std::cerr<<"wrong arg\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_lookups;++i)data.push_back(rng());
+
+  using namespace boost::bloom;
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th>allocator</th>\n"
+    "    <th>size<br/>[MB]</th>\n"
+    "    <th>construction<br/>[ms]</th>\n"
+    "    <th>independent<br/>lookup</th>\n"
+    "    <th>dependent<br/>lookup</th>\n"
+    "  </tr>\n";
+  for(std::size_t mb=16;mb<=max_mb;mb*=4){
+    row("std::allocator",mb,std::allocator<boost::uint64_t>{});
+    row(
+      "huge_page_allocator",mb,huge_page_allocator<boost::uint64_t>{});
+    row(
+      "huge_page_allocator (populate)",mb,
+      huge_page_allocator<boost::uint64_t>{huge_page_flags::populate});
+    row(
+      "huge_page_allocator (explicit)",mb,
+      huge_page_allocator<boost::uint64_t>{
+        huge_page_flags::explicit_huge_pages});
+  }
+  std::cout<<"</table>\n";
+}
@@ -0,0 +1,175 @@
+/* Multithreaded lookup times with NUMA interleaving and replication.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=7;
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    auto t1=high_resolution_clock::now();
+    f();
+    auto t2=high_resolution_clock::now();
+    trials[i]=duration_cast<duration<double>>(t2-t1).count();
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/huge_page_allocator.hpp>
+#include <boost/bloom/replicated_filter.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const std::size_t            num_lookups=10000000;
+static std::size_t                  max_num_threads;
+static std::vector<boost::uint64_t> data;
+
+using namespace boost::bloom;
+
+using filter_type=filter<
+  boost::uint64_t,1,block<boost::uint64_t,7>,0,
+  boost::hash<boost::uint64_t>,huge_page_allocator<boost::uint64_t>>;
+
+/* Lookups are evenly split among num_threads threads, which perform them
+ * in bulk. For a plain filter, the array is either allocated by the main
+ * thread (and thus placed on its NUMA node) or interleaved across all nodes;
+ * replicated_filter routes lookups to the replica on the node of each
+ * thread. Times are in ns per lookup (wall time).
+ */
+
+struct counting_iterator
+{
+  counting_iterator& operator*(){return *this;}
+  counting_iterator& operator++(){return *this;}
+  counting_iterator& operator++(int){return *this;}
+  counting_iterator& operator=(bool b){*n+=b;return *this;}
+
+  std::size_t* n;
+};
+
+template<typename Filter>
+double lookup_time(const Filter& f,std::size_t num_threads)
+{
+  double t=measure([&]{
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> res(num_threads);
+    for(std::size_t i=0;i<num_threads;++i){
+      threads.emplace_back([&,i]{
+        auto first=data.begin()+i*num_lookups/num_threads,
+             last=data.begin()+(i+1)*num_lookups/num_threads;
+        std::size_t r=0;
+        f.may_contain(first,last,counting_iterator{&r});
+        res[i]=r;
+      });
+    }
+    for(auto& th:threads)th.join();
+    volatile std::size_t sum=
+      std::accumulate(res.begin(),res.end(),std::size_t(0));
+    (void)sum;
+  });
+  return t/num_lookups*1E9;
+}
+
+filter_type make_filter(std::size_t mb,unsigned int flags)
+{
+  filter_type f(
+    mb*8*1024*1024,huge_page_allocator<boost::uint64_t>{flags});
+
+  /* random contents, half of the bits set on average */
+
+  boost::detail::splitmix64 rng;
+  for(auto& x:f.array())x=(unsigned char)rng();
+  return f;
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+int main(int argc,char* argv[])
+{
+  std::size_t mb=1024,num_replicas=0;
+  try{
+    if(argc>1)mb=std::stoul(argv[1]);
+    max_num_threads=argc>2?
+      std::stoul(argv[2]):
+      (std::max)(std::thread::hardware_concurrency(),1u);
+    if(argc>3)num_replicas=std::stoul(argv[3]);
+  }
+  catch(...){
+    std::cerr<<
+      "usage: numa_lookup [size in MB [max number of threads "
+      "[number of replicas]]]\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_lookups;++i)data.push_back(rng());
+
+  filter_type f1=make_filter(mb,huge_page_flags::none),
+              f2=make_filter(mb,huge_page_flags::interleave);
+
+  replicated_filter<filter_type> rf=num_replicas?
+    replicated_filter<filter_type>(f1,num_replicas):
+    replicated_filter<filter_type>(f1);
+
+  std::cout<<
+    "<table>\n"
+    "  <tr><th colspan=\"4\">"<<mb<<" MB, "<<rf.num_replicas()<<
+    " replicas</th></tr>\n"
+    "  <tr>\n"
+    "    <th>threads</th>\n"
+    "    <th>local<br/>alloc.</th>\n"
+    "    <th>inter-<br/>leaved</th>\n"
+    "    <th>repli-<br/>cated</th>\n"
+    "  </tr>\n";
+  for(std::size_t n=1;n<=max_num_threads;n*=2){
+    std::cout<<
+      "  <tr>\n"
+      "    <td align=\"center\">"<<n<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(lookup_time(f1,n))<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(lookup_time(f2,n))<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(lookup_time(rf,n))<<"</td>\n"
+      "  </tr>\n";
+    if(n<max_num_threads&&2*n>max_num_threads)n=max_num_threads/2;
+  }
+  std::cout<<"</table>\n";
+}
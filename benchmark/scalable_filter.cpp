@@ -0,0 +1,192 @@
+/* Lookup performance of boost::bloom::scalable_filter as the number of
+ * stages grows, with and without overlapping the memory accesses to the
+ * different stages.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/scalable_filter.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/* output iterator accumulating the number of positive lookups */
+
+struct positive_counter
+{
+  using iterator_category=std::output_iterator_tag;
+  using value_type=void;
+  using difference_type=std::ptrdiff_t;
+  using pointer=void;
+  using reference=void;
+
+  positive_counter& operator*(){return *this;}
+  positive_counter& operator++(){return *this;}
+  positive_counter& operator++(int){return *this;}
+  positive_counter& operator=(bool b){*res+=b;return *this;}
+
+  std::size_t* res;
+};
+
+/* lookup stage by stage from the newest, without overlapping memory
+ * accesses across stages
+ */
+
+template<typename ScalableFilter,typename T>
+bool sequential_may_contain(const ScalableFilter& sf,const T& x)
+{
+  for(std::size_t i=sf.num_stages();i--;){
+    if(sf.stage(i).may_contain(x))return true;
+  }
+  return false;
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+using filter=boost::bloom::filter<int,5>;
+using scalable_filter=boost::bloom::scalable_filter<filter>;
+
+static std::size_t num_elements;
+static const double target_fpr=0.01;
+
+/* unsuccessful lookup times, which visit every stage, in ns per element */
+
+void row(std::size_t initial_n,
+  const std::vector<int>& data_in,const std::vector<int>& data_out)
+{
+  scalable_filter sf(initial_n,target_fpr);
+  for(const auto& x:data_in)sf.insert(x);
+
+  std::size_t res=0;
+  for(const auto& x:data_out)res+=sf.may_contain(x);
+  double fpr=(double)res*100/num_elements;
+
+  double sequential_time=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_out)res+=sequential_may_contain(sf,x);
+    return res;
+  })/num_elements*1E9;
+  double lookup_time=measure([&]{
+    std::size_t res=0;
+    for(const auto& x:data_out)res+=sf.may_contain(x);
+    return res;
+  })/num_elements*1E9;
+  double bulk_lookup_time=measure([&]{
+    std::size_t res=0;
+    sf.may_contain(data_out.begin(),data_out.end(),positive_counter{&res});
+    return res;
+  })/num_elements*1E9;
+
+  std::cout<<
+    "  <tr>\n"
+    "    <td align=\"right\">"<<initial_n<<"</td>\n"
+    "    <td align=\"right\">"<<sf.num_stages()<<"</td>\n"
+    "    <td align=\"right\">"<<
+      print_double((double)sf.capacity()/num_elements,1)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(fpr,4)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(sequential_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(bulk_lookup_time)<<"</td>\n"
+    "  </tr>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<int> data_in,data_out;
+  for(std::size_t i=0;i<num_elements;++i){
+    data_in.push_back((int)i);
+    data_out.push_back((int)(i+num_elements));
+  }
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th>initial n</th>\n"
+    "    <th>stages</th>\n"
+    "    <th>m/n</th>\n"
+    "    <th>FPR<br/>[%]</th>\n"
+    "    <th>seq.<br/>lkp.</th>\n"
+    "    <th>lkp.</th>\n"
+    "    <th>bulk<br/>lkp.</th>\n"
+    "  </tr>\n";
+
+  /* each division of initial_n by 4 adds two stages */
+
+  for(std::size_t initial_n=num_elements;initial_n>=num_elements/1024;
+      initial_n/=4){
+    row(initial_n,data_in,data_out);
+  }
+
+  std::cout<<"</table>\n";
+}
@@ -10,6 +10,7 @@
 
 #include <boost/bloom/filter.hpp>
 #include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/serialization.hpp>
 #include <boost/core/detail/splitmix64.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -53,20 +54,14 @@ filter create_filter()
 void save_filter(const filter& f, const char* filename)
 {
   std::ofstream out(filename, std::ios::binary | std::ios::trunc);
-  std::size_t c=f.capacity();
-  out.write((const char*) &c, sizeof(c)); /* save capacity (bits) */
-  auto s = f.array();
-  out.write((const char*) s.data(), s.size()); /* save array */
+  boost::bloom::save(f, out); /* header, array and checksums */
 }
 
 filter load_filter(const char* filename)
 {
   std::ifstream in(filename, std::ios::binary);
-  std::size_t c;
-  in.read((char*) &c, sizeof(c));
-  filter f(c);
-  auto s = f.array();
-  in.read((char*) s.data(), s.size()); /* load array */
+  filter f;
+  boost::bloom::load(f, in); /* throws if incompatible or corrupted */
   return f;
 }
 
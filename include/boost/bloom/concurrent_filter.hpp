@@ -0,0 +1,46 @@
+/* Bloom filter supporting concurrent insertion and lookup.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_CONCURRENT_FILTER_HPP
+#define BOOST_BLOOM_CONCURRENT_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/atomic_subfilter.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost{
+namespace bloom{
+
+/* filter whose insertion and lookup member functions can be invoked
+ * concurrently from several threads on the same object without external
+ * synchronization. Bits are set with lock-free atomic fetch_or operations
+ * (see <boost/bloom/detail/atomic_subfilter.hpp>), so the array is the
+ * same as that of a plain filter with the same configuration into which the
+ * same elements are inserted, in any order.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t BucketSize=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<T>,
+  typename HashStrategy=mcg_and_fastrange
+>
+using concurrent_filter=filter<
+  T,K,detail::atomic_subfilter<Subfilter,BucketSize>,BucketSize,
+  Hash,Allocator,HashStrategy
+>;
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
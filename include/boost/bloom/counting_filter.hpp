@@ -0,0 +1,323 @@
+/* Bloom filter with counters supporting element erasure.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_COUNTING_FILTER_HPP
+#define BOOST_BLOOM_COUNTING_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/counting_core.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* counting_filter is the counting counterpart of the filter with the same
+ * T, K, Subfilter, BucketSize, Hash, Allocator and HashStrategy: elements
+ * are hashed and mapped to buckets exactly as in filter_type, each bit of
+ * its array being replaced by a CounterBits-bit counter, so that
+ * to_filter() produces the filter_type resulting from inserting the
+ * elements currently in the counting filter.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t BucketSize=0,
+  std::size_t CounterBits=4,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<T>,
+  typename HashStrategy=mcg_and_fastrange
+>
+class
+
+#if defined(_MSC_VER)&&_MSC_FULL_VER>=190023918
+__declspec(empty_bases) /* activate EBO with multiple inheritance */
+#endif
+
+counting_filter:
+  detail::counting_core<
+    K,Subfilter,BucketSize,CounterBits,
+    allocator_rebind_t<Allocator,unsigned char>,HashStrategy
+  >,
+  empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<T,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be T");
+  using super=detail::counting_core<
+    K,Subfilter,BucketSize,CounterBits,
+    allocator_rebind_t<Allocator,unsigned char>,HashStrategy
+  >;
+
+public:
+  using value_type=T;
+  using super::k;
+  using subfilter=typename super::subfilter;
+  using super::bucket_size;
+  using super::counter_bits;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using hash_strategy=HashStrategy;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+  using filter_type=filter<
+    T,K,Subfilter,BucketSize,Hash,Allocator,HashStrategy>;
+
+  counting_filter()=default;
+
+  explicit counting_filter(
+    std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    super{m,al},hash_base{empty_init,h}{}
+
+  counting_filter(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    super{n,fpr,al},hash_base{empty_init,h}{}
+
+  template<typename InputIterator>
+  counting_filter(
+    InputIterator first,InputIterator last,
+    std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    counting_filter{m,h,al}
+  {
+    insert(first,last);
+  }
+
+  template<typename InputIterator>
+  counting_filter(
+    InputIterator first,InputIterator last,
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    counting_filter{n,fpr,h,al}
+  {
+    insert(first,last);
+  }
+
+  counting_filter(const counting_filter&)=default;
+  counting_filter(counting_filter&&)=default;
+
+  counting_filter(
+    std::initializer_list<value_type> il,
+    std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    counting_filter{il.begin(),il.end(),m,h,al}{}
+
+  counting_filter(
+    std::initializer_list<value_type> il,
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    counting_filter{il.begin(),il.end(),n,fpr,h,al}{}
+
+  counting_filter(std::size_t m,const allocator_type& al):
+    counting_filter{m,hasher(),al}{}
+
+  counting_filter(std::size_t n,double fpr,const allocator_type& al):
+    counting_filter{n,fpr,hasher(),al}{}
+
+  counting_filter& operator=(const counting_filter& x)
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    auto x_h=x.h();
+    super::operator=(x);
+    swap(h(),x_h);
+    return *this;
+  }
+
+  counting_filter& operator=(counting_filter&& x)
+    noexcept(noexcept(std::declval<super&>()=(std::declval<super&&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    super::operator=(std::move(x));
+    swap(h(),x.h());
+    return *this;
+  }
+
+  using super::get_allocator;
+  using super::capacity;
+  using super::capacity_for;
+  using super::fpr_for;
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    super::insert(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    super::insert(hash_for(x));
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    for(;first!=last;++first)insert(*first);
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  /* x must have been previously inserted, or else the counters of other
+   * elements may be decremented if x is a false positive
+   */
+
+  BOOST_FORCEINLINE bool erase(const T& x)
+  {
+    return super::erase(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool erase(const U& x)
+  {
+    return super::erase(hash_for(x));
+  }
+
+  void swap(counting_filter& x)
+    noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    super::swap(x);
+    swap(h(),x.h());
+  }
+
+  using super::clear;
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return super::may_contain(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return super::may_contain(hash_for(x));
+  }
+
+  filter_type to_filter()const
+  {
+    filter_type f{capacity(),h(),get_allocator()};
+    super::to_bits(f.array().data());
+    return f;
+  }
+
+private:
+  template<
+    typename T1,std::size_t K1,typename S,std::size_t B,std::size_t C,
+    typename H,typename A,typename HS
+  >
+  bool friend operator==(
+    const counting_filter<T1,K1,S,B,C,H,A,HS>& x,
+    const counting_filter<T1,K1,S,B,C,H,A,HS>& y);
+
+  using hash_base=empty_value<Hash,0>;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const T& x)const
+  {
+    return filter_type::mix_hash(h()(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const U& x)const
+  {
+    return filter_type::mix_hash(h()(x));
+  }
+};
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,std::size_t C,
+  typename H,typename A,typename HS
+>
+bool operator==(
+  const counting_filter<T,K,S,B,C,H,A,HS>& x,
+  const counting_filter<T,K,S,B,C,H,A,HS>& y)
+{
+  using super=typename counting_filter<T,K,S,B,C,H,A,HS>::super;
+  return static_cast<const super&>(x)==static_cast<const super&>(y);
+}
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,std::size_t C,
+  typename H,typename A,typename HS
+>
+bool operator!=(
+  const counting_filter<T,K,S,B,C,H,A,HS>& x,
+  const counting_filter<T,K,S,B,C,H,A,HS>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,std::size_t C,
+  typename H,typename A,typename HS
+>
+void swap(
+  counting_filter<T,K,S,B,C,H,A,HS>& x,counting_filter<T,K,S,B,C,H,A,HS>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
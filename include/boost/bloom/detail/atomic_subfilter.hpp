@@ -0,0 +1,147 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_ATOMIC_SUBFILTER_HPP
+#define BOOST_BLOOM_DETAIL_ATOMIC_SUBFILTER_HPP
+
+#include <boost/atomic/atomic_ref.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Largest lock-free unsigned word type (up to 64 bits) whose size divides
+ * N (N being the GCD of the bucket size and the used value size).
+ */
+
+template<std::size_t N>
+struct atomic_word
+{
+  using type=typename std::conditional<
+    N%8==0&&boost::atomic_ref<boost::uint64_t>::is_always_lock_free,
+    boost::uint64_t,
+    typename std::conditional<
+      N%4==0,boost::uint32_t,
+      typename std::conditional<
+        N%2==0,boost::uint16_t,unsigned char
+      >::type
+    >::type
+  >::type;
+};
+
+constexpr std::size_t constexpr_gcd(std::size_t x,std::size_t y)
+{
+  return y==0?x:constexpr_gcd(y,x%y);
+}
+
+/* Subfilter adaptor making mark and check safe to execute concurrently on
+ * the same block. The bits selected by hash are computed on a local, zeroed
+ * block with Subfilter::mark; mark then ORs them into the array word by word
+ * with atomic fetch_or operations, skipping words with no new bits (so that
+ * the cache line is not invalidated when the element is already present),
+ * and check tests them against words read with atomic loads. This relies on
+ * Subfilter::check(x,hash) being true iff x contains all the bits set by
+ * Subfilter::mark(hash), which is the case for all the subfilters provided
+ * by the library. Words are as large as possible while dividing both the
+ * bucket size and the used value size: value_type is aligned accordingly so
+ * that blocks are always accessed in place by filter_core. Operations use
+ * relaxed memory ordering: concurrent inserts and lookups are free of data
+ * races and any insertion is visible to all lookups happening after it
+ * completes, but they don't synchronize other memory accesses.
+ */
+
+template<typename Subfilter,std::size_t BucketSize>
+struct atomic_subfilter
+{
+private:
+  using block_type=typename Subfilter::value_type;
+
+public:
+  static constexpr std::size_t k=Subfilter::k;
+  static constexpr std::size_t used_value_size=
+    detail::used_value_size<Subfilter>::value;
+
+private:
+  static constexpr std::size_t bucket_size=
+    BucketSize?BucketSize:used_value_size;
+  using word_type=typename atomic_word<
+    constexpr_gcd(bucket_size,used_value_size)>::type;
+  static constexpr std::size_t word_size=sizeof(word_type);
+  static constexpr std::size_t num_words=used_value_size/word_size;
+  using atomic_ref=boost::atomic_ref<word_type>;
+
+public:
+  struct alignas(atomic_ref::required_alignment) value_type
+  {
+    unsigned char data[sizeof(block_type)];
+  };
+
+  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  {
+    block_type m{};
+    Subfilter::mark(m,hash);
+    auto pm=reinterpret_cast<const unsigned char*>(&m);
+    auto px=reinterpret_cast<word_type*>(&x);
+    for(std::size_t i=0;i<num_words;++i){
+      word_type w;
+      std::memcpy(&w,pm+i*word_size,word_size);
+      if(w){
+        atomic_ref r{px[i]};
+        if((r.load(boost::memory_order_relaxed)&w)!=w){
+          r.fetch_or(w,boost::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  {
+    block_type m{};
+    Subfilter::mark(m,hash);
+    auto pm=reinterpret_cast<const unsigned char*>(&m);
+    auto px=reinterpret_cast<word_type*>(const_cast<value_type*>(&x));
+    for(std::size_t i=0;i<num_words;++i){
+      word_type w;
+      std::memcpy(&w,pm+i*word_size,word_size);
+      if((atomic_ref{px[i]}.load(boost::memory_order_relaxed)&w)!=w){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static double fpr(std::size_t i,std::size_t w)
+  {
+    return Subfilter::fpr(i,w);
+  }
+
+  static double marked_bits(std::size_t w)
+  {
+    return Subfilter::marked_bits(w);
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,20 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_AVX512_HPP
+
+#if defined(__AVX512F__)&&defined(__AVX512BW__)
+#define BOOST_BLOOM_AVX512
+#endif
+
+#if defined(BOOST_BLOOM_AVX512)
+#include <immintrin.h>
+#endif
+
+#endif
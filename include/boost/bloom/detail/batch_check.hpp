@@ -0,0 +1,113 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_BATCH_CHECK_HPP
+#define BOOST_BLOOM_DETAIL_BATCH_CHECK_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* batch_check<Subfilter> optionally provides a kernel checking several
+ * elements at once:
+ *
+ *   static constexpr std::size_t width=...;
+ *   static int check(
+ *     const unsigned char* base,const boost::uint64_t* offsets,
+ *     const boost::uint64_t* hashes);
+ *
+ * where the i-th bit of the returned value (i<width) is
+ * Subfilter::check(x,hashes[i]), x being the value located at
+ * base+offsets[i] (which need not be properly aligned for
+ * Subfilter::value_type). width==0 indicates that there is no such kernel.
+ */
+
+template<typename Subfilter,typename=void>
+struct batch_check
+{
+  static constexpr std::size_t width=0;
+};
+
+#if defined(BOOST_BLOOM_AVX2)
+
+/* mulx64 on each of the four 64-bit lanes of x */
+
+BOOST_FORCEINLINE __m256i mulx64_m256i(__m256i x)
+{
+  BOOST_ALIGNMENT(32) boost::uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes),x);
+  for(auto& lane:lanes)lane=mulx64(lane);
+  return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+}
+
+/* four-lane version of block_base<Block,K>::loop */
+
+template<typename BlockBase,typename F>
+BOOST_FORCEINLINE void loop_m256i(__m256i hash,F f)
+{
+  static constexpr int         shift=(int)BlockBase::shift;
+  static constexpr std::size_t k=BlockBase::k;
+  static constexpr std::size_t rehash_k=BlockBase::rehash_k;
+
+  for(std::size_t i=0;i<k/rehash_k;++i){
+    auto h=hash;
+    for(std::size_t j=0;j<rehash_k;++j){
+      h=_mm256_srli_epi64(h,shift);
+      f(h);
+    }
+    hash=mulx64_m256i(hash);
+  }
+  auto h=hash;
+  for(std::size_t i=0;i<k%rehash_k;++i){
+    h=_mm256_srli_epi64(h,shift);
+    f(h);
+  }
+}
+
+/* gathers the (zero-extended) Blocks located at base+offsets[i] */
+
+template<typename Block>
+BOOST_FORCEINLINE __m256i gather_m256i(
+  const unsigned char* base,__m256i offsets,
+  typename std::enable_if<sizeof(Block)==8>::type* =nullptr)
+{
+  return _mm256_i64gather_epi64(
+    reinterpret_cast<const long long*>(base),offsets,1);
+}
+
+template<typename Block>
+BOOST_FORCEINLINE __m256i gather_m256i(
+  const unsigned char* base,__m256i offsets,
+  typename std::enable_if<sizeof(Block)==4>::type* =nullptr)
+{
+  return _mm256_cvtepu32_epi64(
+    _mm256_i64gather_epi32(reinterpret_cast<const int*>(base),offsets,1));
+}
+
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,310 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_BITWISE_HPP
+#define BOOST_BLOOM_DETAIL_BITWISE_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/sse2.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(__AVX512F__)&&defined(__AVX512VPOPCNTDQ__)
+#define BOOST_BLOOM_AVX512_POPCNT
+#endif
+
+/* Bitwise operations over byte ranges, processed a SIMD register (or a
+ * 64-bit word) at a time. Pointers need not be aligned.
+ */
+
+struct left_op
+{
+  template<typename T>
+  static T apply(T x,T){return x;}
+};
+
+struct right_op
+{
+  template<typename T>
+  static T apply(T,T y){return y;}
+};
+
+struct and_op
+{
+  static boost::uint64_t apply(boost::uint64_t x,boost::uint64_t y)
+  {
+    return x&y;
+  }
+#if defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_and_si128(x,y);}
+#endif
+#if defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_and_si256(x,y);}
+#endif
+#if defined(BOOST_BLOOM_AVX512_POPCNT)
+  static __m512i apply(__m512i x,__m512i y){return _mm512_and_si512(x,y);}
+#endif
+};
+
+struct or_op
+{
+  static boost::uint64_t apply(boost::uint64_t x,boost::uint64_t y)
+  {
+    return x|y;
+  }
+#if defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_or_si128(x,y);}
+#endif
+#if defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_or_si256(x,y);}
+#endif
+#if defined(BOOST_BLOOM_AVX512_POPCNT)
+  static __m512i apply(__m512i x,__m512i y){return _mm512_or_si512(x,y);}
+#endif
+};
+
+struct xor_op
+{
+  static boost::uint64_t apply(boost::uint64_t x,boost::uint64_t y)
+  {
+    return x^y;
+  }
+#if defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_xor_si128(x,y);}
+#endif
+#if defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_xor_si256(x,y);}
+#endif
+};
+
+struct and_not_op
+{
+  static boost::uint64_t apply(boost::uint64_t x,boost::uint64_t y)
+  {
+    return x&~y;
+  }
+#if defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_andnot_si128(y,x);}
+#endif
+#if defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_andnot_si256(y,x);}
+#endif
+};
+
+/* x[i]=Op::apply(x[i],y[i]) for i<n */
+
+template<typename Op>
+void bitwise_assign(unsigned char* x,const unsigned char* y,std::size_t n)
+{
+  std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+  for(;i+32<=n;i+=32){
+    auto px=reinterpret_cast<__m256i*>(x+i);
+    auto py=reinterpret_cast<const __m256i*>(y+i);
+    _mm256_storeu_si256(
+      px,Op::apply(_mm256_loadu_si256(px),_mm256_loadu_si256(py)));
+  }
+#elif defined(BOOST_BLOOM_SSE2)
+  for(;i+16<=n;i+=16){
+    auto px=reinterpret_cast<__m128i*>(x+i);
+    auto py=reinterpret_cast<const __m128i*>(y+i);
+    _mm_storeu_si128(px,Op::apply(_mm_loadu_si128(px),_mm_loadu_si128(py)));
+  }
+#endif
+  for(;i+8<=n;i+=8){
+    boost::uint64_t wx,wy;
+    std::memcpy(&wx,x+i,8);
+    std::memcpy(&wy,y+i,8);
+    wx=Op::apply(wx,wy);
+    std::memcpy(x+i,&wx,8);
+  }
+  for(;i<n;++i){
+    x[i]=(unsigned char)Op::apply(x[i],y[i]);
+  }
+}
+
+/* whether all bits set in x are also set in y (x[i]&~y[i]==0 for i<n) */
+
+inline bool bitwise_is_subset(
+  const unsigned char* x,const unsigned char* y,std::size_t n)
+{
+  std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+  for(;i+32<=n;i+=32){
+    if(!_mm256_testc_si256(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y+i)),
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x+i))))
+      return false;
+  }
+#elif defined(BOOST_BLOOM_SSE2)
+  for(;i+16<=n;i+=16){
+    __m128i d=_mm_andnot_si128(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(y+i)),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(x+i)));
+    if(_mm_movemask_epi8(_mm_cmpeq_epi8(d,_mm_setzero_si128()))!=0xFFFF)
+      return false;
+  }
+#endif
+  for(;i+8<=n;i+=8){
+    boost::uint64_t wx,wy;
+    std::memcpy(&wx,x+i,8);
+    std::memcpy(&wy,y+i,8);
+    if(wx&~wy)return false;
+  }
+  for(;i<n;++i){
+    if(x[i]&~y[i])return false;
+  }
+  return true;
+}
+
+/* res[j] = number of bits set in Ops[j]::apply(x[i],y[i]) for i<n,
+ * computed in one pass. With AVX2, popcounts of 4-bit nibbles are looked
+ * up with _mm256_shuffle_epi8 and summed bytewise for up to 31 iterations
+ * before being widened with _mm256_sad_epu8 (Mula's algorithm). SSE2
+ * lacks byte shuffles, so bytewise popcounts are calculated with the
+ * usual bit-twiddling reduction.
+ */
+
+#if defined(BOOST_BLOOM_AVX512_POPCNT)
+inline std::size_t sum_lanes(__m512i x)
+{
+  BOOST_ALIGNMENT(64) boost::uint64_t lanes[8];
+  _mm512_store_si512(lanes,x);
+  std::size_t res=0;
+  for(auto lane:lanes)res+=(std::size_t)lane;
+  return res;
+}
+#elif defined(BOOST_BLOOM_AVX2)
+inline __m256i popcount_epi8(__m256i x)
+{
+  const __m256i lookup=_mm256_setr_epi8(
+                  0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                  0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4),
+                low_mask=_mm256_set1_epi8(0x0f);
+  return _mm256_add_epi8(
+    _mm256_shuffle_epi8(lookup,_mm256_and_si256(x,low_mask)),
+    _mm256_shuffle_epi8(
+      lookup,_mm256_and_si256(_mm256_srli_epi16(x,4),low_mask)));
+}
+
+inline std::size_t sum_lanes(__m256i x)
+{
+  BOOST_ALIGNMENT(32) boost::uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes),x);
+  return (std::size_t)(lanes[0]+lanes[1]+lanes[2]+lanes[3]);
+}
+#elif defined(BOOST_BLOOM_SSE2)
+inline __m128i popcount_epi8(__m128i x)
+{
+  const __m128i m1=_mm_set1_epi8(0x55),
+                m2=_mm_set1_epi8(0x33),
+                m4=_mm_set1_epi8(0x0f);
+  x=_mm_sub_epi8(x,_mm_and_si128(_mm_srli_epi16(x,1),m1));
+  x=_mm_add_epi8(_mm_and_si128(x,m2),_mm_and_si128(_mm_srli_epi16(x,2),m2));
+  return _mm_and_si128(_mm_add_epi8(x,_mm_srli_epi16(x,4)),m4);
+}
+
+inline std::size_t sum_lanes(__m128i x)
+{
+  BOOST_ALIGNMENT(16) boost::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes),x);
+  return (std::size_t)(lanes[0]+lanes[1]);
+}
+#endif
+
+template<typename... Ops>
+void bitwise_popcounts(
+  const unsigned char* x,const unsigned char* y,std::size_t n,
+  std::size_t (&res)[sizeof...(Ops)])
+{
+  static constexpr std::size_t N=sizeof...(Ops);
+
+  std::size_t i=0;
+  for(auto& r:res)r=0;
+#if defined(BOOST_BLOOM_AVX512_POPCNT)
+  __m512i acc[N];
+  for(auto& a:acc)a=_mm512_setzero_si512();
+  for(;i+64<=n;i+=64){
+    __m512i vx=_mm512_loadu_si512(x+i),
+            vy=_mm512_loadu_si512(y+i),
+            v[N]={Ops::apply(vx,vy)...};
+    for(std::size_t j=0;j<N;++j){
+      acc[j]=_mm512_add_epi64(acc[j],_mm512_popcnt_epi64(v[j]));
+    }
+  }
+  for(std::size_t j=0;j<N;++j)res[j]+=sum_lanes(acc[j]);
+#elif defined(BOOST_BLOOM_AVX2)
+  __m256i acc[N];
+  for(auto& a:acc)a=_mm256_setzero_si256();
+  while(i+32<=n){
+    __m256i cnt[N];
+    for(auto& c:cnt)c=_mm256_setzero_si256();
+    for(int r=0;r<31&&i+32<=n;++r,i+=32){
+      __m256i vx=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x+i)),
+              vy=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y+i)),
+              v[N]={Ops::apply(vx,vy)...};
+      for(std::size_t j=0;j<N;++j){
+        cnt[j]=_mm256_add_epi8(cnt[j],popcount_epi8(v[j]));
+      }
+    }
+    for(std::size_t j=0;j<N;++j){
+      acc[j]=_mm256_add_epi64(
+        acc[j],_mm256_sad_epu8(cnt[j],_mm256_setzero_si256()));
+    }
+  }
+  for(std::size_t j=0;j<N;++j)res[j]+=sum_lanes(acc[j]);
+#elif defined(BOOST_BLOOM_SSE2)
+  __m128i acc[N];
+  for(auto& a:acc)a=_mm_setzero_si128();
+  for(;i+16<=n;i+=16){
+    __m128i vx=_mm_loadu_si128(reinterpret_cast<const __m128i*>(x+i)),
+            vy=_mm_loadu_si128(reinterpret_cast<const __m128i*>(y+i)),
+            v[N]={Ops::apply(vx,vy)...};
+    for(std::size_t j=0;j<N;++j){
+      acc[j]=_mm_add_epi64(
+        acc[j],_mm_sad_epu8(popcount_epi8(v[j]),_mm_setzero_si128()));
+    }
+  }
+  for(std::size_t j=0;j<N;++j)res[j]+=sum_lanes(acc[j]);
+#endif
+  for(;i+8<=n;i+=8){
+    boost::uint64_t wx,wy;
+    std::memcpy(&wx,x+i,8);
+    std::memcpy(&wy,y+i,8);
+    boost::uint64_t w[N]={Ops::apply(wx,wy)...};
+    for(std::size_t j=0;j<N;++j){
+      res[j]+=(std::size_t)boost::core::popcount(w[j]);
+    }
+  }
+  for(;i<n;++i){
+    boost::uint64_t wx=x[i],wy=y[i],
+                    w[N]={Ops::apply(wx,wy)...};
+    for(std::size_t j=0;j<N;++j){
+      res[j]+=(std::size_t)boost::core::popcount(w[j]);
+    }
+  }
+}
+
+inline std::size_t bitwise_popcount(const unsigned char* x,std::size_t n)
+{
+  std::size_t res[1];
+  bitwise_popcounts<left_op>(x,x,n,res);
+  return res[0];
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
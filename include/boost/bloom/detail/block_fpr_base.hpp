@@ -23,6 +23,13 @@ struct block_fpr_base
   {
     return std::pow(1.0-std::pow(1.0-1.0/w,(double)K*i),(double)K);
   }
+
+  /* expected number of distinct bits set by a mark on a w-bit block */
+
+  static double marked_bits(std::size_t w)
+  {
+    return w*(1.0-std::pow(1.0-1.0/w,(double)K));
+  }
 };
 
 } /* namespace detail */
@@ -0,0 +1,128 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COMPACTION_HPP
+#define BOOST_BLOOM_DETAIL_COMPACTION_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/sse2.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Branchless conversion of the results of a bulk lookup into a bitmask or
+ * a selection vector (the indices of the positive results), used by
+ * filter::may_contain_bitmap and filter::may_contain_selection.
+ * res points to an array of compaction_size() bools, of which only the
+ * first n (<=compaction_size()) are considered.
+ */
+
+constexpr std::size_t compaction_size()noexcept{return 16;}
+
+inline boost::uint32_t bool_mask(const bool* res,std::size_t n)noexcept
+{
+#if defined(BOOST_BLOOM_SSE2)
+  static_assert(sizeof(bool)==1,"bool must occupy one byte");
+
+  __m128i        x=_mm_loadu_si128(reinterpret_cast<const __m128i*>(res));
+  boost::uint32_t mask=(boost::uint32_t)
+    (~_mm_movemask_epi8(_mm_cmpeq_epi8(x,_mm_setzero_si128()))&0xFFFF);
+  return mask&((boost::uint32_t(1)<<n)-1);
+#else
+  boost::uint32_t mask=0;
+  for(std::size_t i=0;i<n;++i)mask|=(boost::uint32_t)res[i]<<i;
+  return mask;
+#endif
+}
+
+#if defined(BOOST_BLOOM_AVX2)&&!defined(BOOST_BLOOM_AVX512)
+
+/* entry m holds the positions of the bits set in m packed as bytes */
+
+struct compaction_table
+{
+  compaction_table()noexcept
+  {
+    for(boost::uint32_t m=0;m<256;++m){
+      boost::uint64_t entry=0;
+      int             shift=0;
+      for(boost::uint64_t i=0;i<8;++i){
+        if(m&(1u<<i)){
+          entry|=i<<shift;
+          shift+=8;
+        }
+      }
+      entries[m]=entry;
+    }
+  }
+
+  boost::uint64_t entries[256];
+};
+
+inline const compaction_table& get_compaction_table()noexcept
+{
+  static const compaction_table t;
+  return t;
+}
+
+#endif
+
+/* Writes base+i to out for every i such that res[i] is true, and returns
+ * the number of indices written. Positions of out past those indices (but
+ * less than n) may be overwritten as well.
+ */
+
+inline std::size_t compact_selection(
+  const bool* res,std::size_t n,boost::uint32_t base,boost::uint32_t* out)
+  noexcept
+{
+#if defined(BOOST_BLOOM_AVX512)
+  if(n==compaction_size()){
+    boost::uint32_t mask=bool_mask(res,n);
+    __m512i         indices=_mm512_add_epi32(
+      _mm512_set1_epi32((int)base),
+      _mm512_set_epi32(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0));
+    _mm512_mask_compressstoreu_epi32(out,(__mmask16)mask,indices);
+    return (std::size_t)boost::core::popcount(mask);
+  }
+#elif defined(BOOST_BLOOM_AVX2)
+  if(n==compaction_size()){
+    const auto&     t=get_compaction_table();
+    boost::uint32_t mask=bool_mask(res,n);
+    std::size_t     m=0;
+    for(int half=0;half<2;++half){
+      boost::uint32_t m8=(mask>>(8*half))&0xFFu;
+      __m256i         indices=_mm256_add_epi32(
+        _mm256_set1_epi32((int)(base+8*half)),
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+          reinterpret_cast<const __m128i*>(&t.entries[m8]))));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+m),indices);
+      m+=(std::size_t)boost::core::popcount(m8);
+    }
+    return m;
+  }
+#endif
+
+  std::size_t m=0;
+  for(std::size_t i=0;i<n;++i){
+    out[m]=base+(boost::uint32_t)i;
+    m+=res[i];
+  }
+  return m;
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
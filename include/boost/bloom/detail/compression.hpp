@@ -0,0 +1,584 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COMPRESSION_HPP
+#define BOOST_BLOOM_DETAIL_COMPRESSION_HPP
+
+#include <boost/bloom/detail/runtime_dispatch.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+/* Decoding of packed bytes uses byte shuffles (pshufb) when SSSE3 is
+ * enabled at compile time or, with runtime dispatch, on CPUs supporting
+ * AVX2; on little-endian AArch64, Neon's tbl is used.
+ */
+
+#if defined(__SSSE3__)||defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#define BOOST_BLOOM_COMPRESSION_SSSE3
+#include <tmmintrin.h>
+#if !defined(__SSSE3__)&&(defined(BOOST_GCC)||defined(BOOST_CLANG))
+#define BOOST_BLOOM_COMPRESSION_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+#elif defined(__aarch64__)&&defined(__ARM_NEON)&&!defined(__AARCH64EB__)
+#define BOOST_BLOOM_COMPRESSION_NEON
+#include <arm_neon.h>
+#endif
+
+#if !defined(BOOST_BLOOM_COMPRESSION_SSSE3_TARGET)
+#define BOOST_BLOOM_COMPRESSION_SSSE3_TARGET
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Compression of sparse filter arrays. The array is divided into regions
+ * of compression_region_size bytes (the last one possibly shorter), each
+ * encoded as one of:
+ *
+ *   - zero run: tag, varint number r of consecutive all-zero regions.
+ *   - raw: tag, region bytes.
+ *   - Elias-Fano: tag, varint number n of bits set, positions of the bits
+ *     set in Elias-Fano representation with l=floor(log2(u/n)) low bits,
+ *     u being the number of bits of the region: n*l bits with the low
+ *     parts of the positions (LSB first, padded to a byte boundary)
+ *     followed by a bitmap of n+((u-1)>>l)+1 bits where the i-th bit set is
+ *     at position i+(the i-th position>>l) (padded to a byte boundary).
+ *   - packed bytes: tag, bitmap of the non-zero bytes of the region (padded
+ *     to a byte boundary) followed by the non-zero bytes.
+ *
+ * The encoder picks the smallest representation for each region, except
+ * that Elias-Fano is only used for fill ratios up to 1/64, as its decoding
+ * time is proportional to the number of bits set: above that, packed
+ * bytes decode faster with modest loss in compression. Encoded data is
+ * followed by compression_slack zero bytes so that the decoder can read
+ * 64-bit words without bound checks. Decoding never writes outside the
+ * destination even for malformed input, which is reported by throwing
+ * std::runtime_error.
+ */
+
+static constexpr std::size_t compression_region_size=4096;
+static constexpr std::size_t compression_slack=8;
+static constexpr std::size_t compression_ef_max_fill=64; /* 1/64 */
+
+enum compression_tag:unsigned char
+{
+  compression_zero_run=0,
+  compression_raw,
+  compression_elias_fano,
+  compression_packed_bytes
+};
+
+inline boost::uint64_t compression_load64(const unsigned char* p)
+{
+  boost::uint64_t x;
+  std::memcpy(&x,p,sizeof(x));
+#if BOOST_ENDIAN_BIG_BYTE
+  x=__builtin_bswap64(x);
+#endif
+  return x;
+}
+
+inline void compression_store64(unsigned char* p,boost::uint64_t x)
+{
+#if BOOST_ENDIAN_BIG_BYTE
+  x=__builtin_bswap64(x);
+#endif
+  std::memcpy(p,&x,sizeof(x));
+}
+
+inline unsigned char* compression_put_varint(
+  unsigned char* p,std::size_t x)
+{
+  for(;x>=0x80;x>>=7)*p++=(unsigned char)(x|0x80);
+  *p++=(unsigned char)x;
+  return p;
+}
+
+inline std::size_t compression_varint_size(std::size_t x)
+{
+  std::size_t n=1;
+  for(;x>=0x80;x>>=7)++n;
+  return n;
+}
+
+[[noreturn]] inline void compression_throw_malformed()
+{
+  BOOST_THROW_EXCEPTION(std::runtime_error("malformed compressed data"));
+}
+
+inline const unsigned char* compression_get_varint(
+  const unsigned char* p,const unsigned char* last,std::size_t& x)
+{
+  x=0;
+  for(int s=0;;s+=7){
+    if(p==last||s>=(int)(sizeof(std::size_t)*8))compression_throw_malformed();
+    unsigned char c=*p++;
+    x|=(std::size_t)(c&0x7F)<<s;
+    if(!(c&0x80))return p;
+  }
+}
+
+inline std::size_t compression_low_bits(std::size_t u,std::size_t n)
+{
+  std::size_t l=0;
+  while((n<<(l+1))<=u)++l;
+  return l;
+}
+
+/* byte sizes of the low and high parts of the Elias-Fano representation */
+
+inline std::size_t compression_ef_low_size(std::size_t n,std::size_t l)
+{
+  return (n*l+7)/8;
+}
+
+inline std::size_t compression_ef_high_size(
+  std::size_t u,std::size_t n,std::size_t l)
+{
+  return (n+((u-1)>>l)+1+7)/8;
+}
+
+/* byte i of the result is 1 if byte i of x is not zero, 0 otherwise */
+
+inline boost::uint64_t compression_nonzero_flags(boost::uint64_t x)
+{
+  x|=x>>4;
+  x|=x>>2;
+  x|=x>>1;
+  return x&0x0101010101010101ull;
+}
+
+/* bit i of the result is set iff byte i of x is not zero */
+
+inline unsigned int compression_nonzero_bytes(boost::uint64_t x)
+{
+  return (unsigned int)(
+    (compression_nonzero_flags(x)*0x0102040810204080ull)>>56);
+}
+
+inline std::size_t compression_count_nonzero_bytes(boost::uint64_t x)
+{
+  return (std::size_t)(
+    (compression_nonzero_flags(x)*0x0101010101010101ull)>>56);
+}
+
+/* byte i of offsets[m] is the number of bits of m below bit i, byte i of
+ * masks[m] is 0xFF if bit i of m is set and 0 otherwise, and shuffles[m]
+ * is offsets[m] with bytes not in masks[m] set to 0x80, which makes
+ * pshufb/tbl output zero for them
+ */
+
+struct compression_deposit_tables
+{
+  compression_deposit_tables()
+  {
+    for(unsigned int m=0;m<256;++m){
+      offsets[m]=masks[m]=0;
+      for(unsigned int i=0,c=0;i<8;++i){
+        offsets[m]|=(boost::uint64_t)c<<(8*i);
+        if(m&(1u<<i)){
+          masks[m]|=(boost::uint64_t)0xFF<<(8*i);
+          ++c;
+        }
+      }
+      shuffles[m]=offsets[m]|(~masks[m]&0x8080808080808080ull);
+    }
+  }
+
+  /* number of bits set in m */
+
+  std::size_t popcount(unsigned int m)const
+  {
+    return (std::size_t)(offsets[m]>>56)+(m>>7);
+  }
+
+  boost::uint64_t offsets[256];
+  boost::uint64_t masks[256];
+  boost::uint64_t shuffles[256];
+};
+
+inline const compression_deposit_tables& compression_deposit_table()
+{
+  static const compression_deposit_tables tables;
+  return tables;
+}
+
+/* places the first bytes of [p,p+8) into the bytes of the result
+ * indicated by the bits set in m (the rest being zero), as pdep does at bit
+ * level
+ */
+
+inline boost::uint64_t compression_deposit_bytes(
+  const unsigned char* p,unsigned int m,
+  const compression_deposit_tables& t)
+{
+#if defined(BOOST_BLOOM_COMPRESSION_NEON)
+  return vget_lane_u64(vreinterpret_u64_u8(vtbl1_u8(
+    vld1_u8(p),vld1_u8((const boost::uint8_t*)&t.shuffles[m]))),0);
+#else
+  /* loads are independent of each other, unlike in a byte-by-byte loop,
+   * and are written out so that all shifts are by constant amounts
+   */
+
+  boost::uint64_t off=t.offsets[m];
+  return t.masks[m]&(
+    (boost::uint64_t)p[ off     &0xFF]    |
+    (boost::uint64_t)p[(off>> 8)&0xFF]<< 8|
+    (boost::uint64_t)p[(off>>16)&0xFF]<<16|
+    (boost::uint64_t)p[(off>>24)&0xFF]<<24|
+    (boost::uint64_t)p[(off>>32)&0xFF]<<32|
+    (boost::uint64_t)p[(off>>40)&0xFF]<<40|
+    (boost::uint64_t)p[(off>>48)&0xFF]<<48|
+    (boost::uint64_t)p[ off>>56      ]<<56);
+#endif
+}
+
+#if defined(BOOST_BLOOM_COMPRESSION_SSSE3)
+BOOST_FORCEINLINE BOOST_BLOOM_COMPRESSION_SSSE3_TARGET
+boost::uint64_t compression_deposit_bytes_ssse3(
+  const unsigned char* p,unsigned int m,
+  const compression_deposit_tables& t)
+{
+  boost::uint64_t res;
+  _mm_storel_epi64(
+    (__m128i*)&res,
+    _mm_shuffle_epi8(
+      _mm_loadl_epi64((const __m128i*)p),
+      _mm_loadl_epi64((const __m128i*)&t.shuffles[m])));
+  return res;
+}
+#endif
+
+/* encodes region [p,p+r) (r<=compression_region_size) at out, which must
+ * have room for 1+r bytes plus compression_slack
+ */
+
+inline unsigned char* compress_region(
+  const unsigned char* p,std::size_t r,unsigned char* out)
+{
+  static constexpr std::size_t max_words=compression_region_size/8;
+
+  boost::uint64_t words[max_words];
+  std::size_t     num_words=(r+7)/8,u=r*8,n=0,nnz=0;
+  words[num_words-1]=0;
+  std::memcpy(words,p,r);
+  for(std::size_t i=0;i<num_words;++i){
+    words[i]=compression_load64((const unsigned char*)&words[i]);
+    nnz+=compression_count_nonzero_bytes(words[i]);
+  }
+
+  /* n>=nnz, so the number of bits set need only be calculated when
+   * Elias-Fano is eligible
+   */
+
+  std::size_t ef_size=(std::size_t)-1;
+  if(nnz<=u/compression_ef_max_fill){
+    for(std::size_t i=0;i<num_words;++i){
+      n+=(std::size_t)core::popcount(words[i]);
+    }
+    if(n<=u/compression_ef_max_fill){
+      std::size_t l=compression_low_bits(u,n);
+      ef_size=
+        compression_varint_size(n)+compression_ef_low_size(n,l)+
+        compression_ef_high_size(u,n,l);
+    }
+  }
+
+  std::size_t raw_size=r,
+              packed_size=(r+7)/8+nnz;
+
+  if(ef_size<=packed_size&&ef_size<=raw_size){
+    std::size_t l=compression_low_bits(u,n);
+    *out++=compression_elias_fano;
+    out=compression_put_varint(out,n);
+    auto low=out,high=out+compression_ef_low_size(n,l);
+    out=high+compression_ef_high_size(u,n,l);
+    std::memset(low,0,(std::size_t)(out-low)+compression_slack);
+    for(std::size_t i=0,j=0;i<num_words;++i){
+      for(auto w=words[i];w;w&=w-1,++j){
+        std::size_t pos=i*64+(std::size_t)core::countr_zero(w),
+                    lbit=j*l,
+                    hbit=j+(pos>>l);
+        auto        q=low+lbit/8;
+        compression_store64(
+          q,compression_load64(q)|
+            (boost::uint64_t)(pos&((std::size_t(1)<<l)-1))<<(lbit%8));
+        high[hbit/8]|=(unsigned char)(1u<<(hbit%8));
+      }
+    }
+  }
+  else if(packed_size<raw_size){
+    *out++=compression_packed_bytes;
+    auto bitmap=out,bytes=out+(r+7)/8;
+    for(std::size_t i=0;i<num_words;++i){
+      auto w=words[i];
+      auto m=compression_nonzero_bytes(w);
+      bitmap[i]=(unsigned char)m;
+      for(int j=0;j<8;++j,w>>=8){ /* branchless, writes into the slack */
+        *bytes=(unsigned char)w;
+        bytes+=(m>>j)&1;
+      }
+    }
+    out=bytes;
+  }
+  else{
+    *out++=compression_raw;
+    std::memcpy(out,p,r);
+    out+=r;
+  }
+  return out;
+}
+
+inline bool compression_is_zero(const unsigned char* p,std::size_t r)
+{
+  boost::uint64_t x=0;
+  std::size_t     i=0;
+  for(;i+8<=r;i+=8)x|=compression_load64(p+i);
+  for(;i<r;++i)x|=p[i];
+  return x==0;
+}
+
+/* maximum size of the encoding of n bytes */
+
+inline std::size_t compression_max_size(std::size_t n)
+{
+  static constexpr std::size_t region_size=compression_region_size;
+
+  return (n+region_size-1)/region_size*(1+region_size)+compression_slack;
+}
+
+/* appends the encoding of [p,p+n) to out */
+
+inline void compress_array(
+  const unsigned char* p,std::size_t n,std::vector<unsigned char>& out)
+{
+  static constexpr std::size_t region_size=compression_region_size;
+
+  std::size_t num_regions=(n+region_size-1)/region_size,
+              first=out.size();
+  out.resize(first+compression_max_size(n)+compression_slack);
+  auto q=out.data()+first;
+  for(std::size_t i=0;i<num_regions;){
+    std::size_t r=(std::min)(region_size,n-i*region_size);
+    if(compression_is_zero(p+i*region_size,r)){
+      std::size_t j=i+1;
+      while(j<num_regions&&
+            compression_is_zero(
+              p+j*region_size,(std::min)(region_size,n-j*region_size))){
+        ++j;
+      }
+      *q++=compression_zero_run;
+      q=compression_put_varint(q,j-i);
+      i=j;
+    }
+    else{
+      q=compress_region(p+i*region_size,r,q);
+      ++i;
+    }
+  }
+  std::memset(q,0,compression_slack);
+  out.resize((std::size_t)(q-out.data())+compression_slack);
+}
+
+template<bool Merge>
+inline void decompression_copy(
+  unsigned char* dst,const unsigned char* src,std::size_t r)
+{
+  if(Merge){
+    std::size_t i=0;
+    for(;i+8<=r;i+=8){
+      boost::uint64_t x,y;
+      std::memcpy(&x,dst+i,8);
+      std::memcpy(&y,src+i,8);
+      x|=y;
+      std::memcpy(dst+i,&x,8);
+    }
+    for(;i<r;++i)dst[i]|=src[i];
+  }
+  else std::memcpy(dst,src,r);
+}
+
+template<bool Merge>
+const unsigned char* decompress_elias_fano(
+  const unsigned char* p,const unsigned char* last,
+  unsigned char* dst,std::size_t r)
+{
+  std::size_t n,u=r*8;
+  p=compression_get_varint(p,last,n);
+  if(n==0||n>u)compression_throw_malformed();
+  std::size_t l=compression_low_bits(u,n),
+              low_size=compression_ef_low_size(n,l),
+              high_size=compression_ef_high_size(u,n,l);
+  if((std::size_t)(last-p)<low_size+high_size+compression_slack){
+    compression_throw_malformed();
+  }
+
+  if(!Merge)std::memset(dst,0,r);
+  auto                  low=p,high=p+low_size;
+  const boost::uint64_t lmask=(boost::uint64_t(1)<<l)-1;
+  std::size_t           i=0,lbit=0,base=0;
+  for(std::size_t hw=0;hw<high_size;hw+=8,base+=64){
+    auto w=compression_load64(high+hw);
+    if(high_size-hw<8)w&=(boost::uint64_t(1)<<((high_size-hw)*8))-1;
+    for(;w;w&=w-1,++i,lbit+=l){
+      if(BOOST_UNLIKELY(i>=n))compression_throw_malformed();
+      std::size_t pos=
+        (base+(std::size_t)core::countr_zero(w)-i)<<l|
+        (std::size_t)((compression_load64(low+lbit/8)>>(lbit%8))&lmask);
+      if(BOOST_UNLIKELY(pos>=u))compression_throw_malformed();
+      dst[pos/8]|=(unsigned char)(1u<<(pos%8));
+    }
+  }
+  if(i!=n)compression_throw_malformed();
+  return high+high_size;
+}
+
+/* stores the 8 bytes of x at dst+i (less if i+8>r) */
+
+template<bool Merge>
+BOOST_FORCEINLINE void decompression_store(
+  unsigned char* dst,std::size_t i,std::size_t r,boost::uint64_t x)
+{
+  if(BOOST_LIKELY(i+8<=r)){
+    if(Merge)x|=compression_load64(dst+i);
+    compression_store64(dst+i,x);
+  }
+  else{
+    for(;i<r;++i,x>>=8){
+      if(Merge)dst[i]|=(unsigned char)x;
+      else     dst[i]=(unsigned char)x;
+    }
+  }
+}
+
+/* The loop body is repeated so that deposit is inlined into code compiled
+ * for its target.
+ */
+
+template<bool Merge>
+const unsigned char* decompress_packed_bytes_generic(
+  const unsigned char* bitmap,const unsigned char* bytes,
+  unsigned char* dst,std::size_t r)
+{
+  const auto& t=compression_deposit_table();
+  for(std::size_t i=0;i<r;i+=8){
+    unsigned int m=*bitmap++;
+    decompression_store<Merge>(dst,i,r,compression_deposit_bytes(bytes,m,t));
+    bytes+=t.popcount(m);
+  }
+  return bytes;
+}
+
+#if defined(BOOST_BLOOM_COMPRESSION_SSSE3)
+template<bool Merge>
+BOOST_BLOOM_COMPRESSION_SSSE3_TARGET
+const unsigned char* decompress_packed_bytes_ssse3(
+  const unsigned char* bitmap,const unsigned char* bytes,
+  unsigned char* dst,std::size_t r)
+{
+  const auto& t=compression_deposit_table();
+  for(std::size_t i=0;i<r;i+=8){
+    unsigned int m=*bitmap++;
+    decompression_store<Merge>(
+      dst,i,r,compression_deposit_bytes_ssse3(bytes,m,t));
+    bytes+=t.popcount(m);
+  }
+  return bytes;
+}
+#endif
+
+template<bool Merge>
+const unsigned char* decompress_packed_bytes(
+  const unsigned char* p,const unsigned char* last,
+  unsigned char* dst,std::size_t r)
+{
+  std::size_t bitmap_size=(r+7)/8;
+  if((std::size_t)(last-p)<bitmap_size+compression_slack){
+    compression_throw_malformed();
+  }
+
+  const auto& t=compression_deposit_table();
+  auto        bitmap=p,bytes=p+bitmap_size;
+  std::size_t nnz=0;
+  for(std::size_t i=0;i<bitmap_size;++i)nnz+=t.popcount(bitmap[i]);
+  if((std::size_t)(last-bytes)<nnz+compression_slack||
+     (r%8&&bitmap[bitmap_size-1]>>(r%8))){
+    compression_throw_malformed();
+  }
+
+#if defined(__SSSE3__)
+  return decompress_packed_bytes_ssse3<Merge>(bitmap,bytes,dst,r);
+#elif defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+  if(runtime_simd_level()!=simd_level::generic){
+    return decompress_packed_bytes_ssse3<Merge>(bitmap,bytes,dst,r);
+  }
+  return decompress_packed_bytes_generic<Merge>(bitmap,bytes,dst,r);
+#else
+  return decompress_packed_bytes_generic<Merge>(bitmap,bytes,dst,r);
+#endif
+}
+
+/* decodes [p,last) (including trailing slack) into [dst,dst+n), ORing the
+ * decoded array into dst if Merge is true
+ */
+
+template<bool Merge>
+void decompress_array(
+  const unsigned char* p,const unsigned char* last,
+  unsigned char* dst,std::size_t n)
+{
+  static constexpr std::size_t region_size=compression_region_size;
+
+  std::size_t num_regions=(n+region_size-1)/region_size;
+  for(std::size_t i=0;i<num_regions;){
+    if((std::size_t)(last-p)<1+compression_slack)compression_throw_malformed();
+    auto        q=dst+i*region_size;
+    std::size_t r=(std::min)(region_size,n-i*region_size);
+    switch(*p++){
+      case compression_zero_run:{
+        std::size_t c;
+        p=compression_get_varint(p,last,c);
+        if(c==0||c>num_regions-i)compression_throw_malformed();
+        if(!Merge)std::memset(q,0,(std::min)(c*region_size,n-i*region_size));
+        i+=c;
+        continue;
+      }
+      case compression_raw:
+        if((std::size_t)(last-p)<r+compression_slack){
+          compression_throw_malformed();
+        }
+        decompression_copy<Merge>(q,p,r);
+        p+=r;
+        break;
+      case compression_elias_fano:
+        p=decompress_elias_fano<Merge>(p,last,q,r);
+        break;
+      case compression_packed_bytes:
+        p=decompress_packed_bytes<Merge>(p,last,q,r);
+        break;
+      default:
+        compression_throw_malformed();
+    }
+    ++i;
+  }
+  if((std::size_t)(last-p)!=compression_slack)compression_throw_malformed();
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -13,8 +13,11 @@
 
 #include <algorithm>
 #include <boost/assert.hpp>
-#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/batch_check.hpp>
+#include <boost/bloom/detail/bitwise.hpp>
+#include <boost/bloom/detail/constexpr_bit_width.hpp>
 #include <boost/bloom/detail/sse2.hpp>
+#include <boost/bloom/hash_strategy.hpp>
 #include <boost/config.hpp>
 #include <boost/core/allocator_traits.hpp>
 #include <boost/core/empty_value.hpp>
@@ -53,6 +56,13 @@ _mm_prefetch((const char*)(p),_MM_HINT_T0)
 
 namespace boost{
 namespace bloom{
+
+template<
+  typename T,std::size_t K,typename Subfilter,std::size_t BucketSize,
+  typename Hash,typename Allocator,typename HashStrategy
+>
+class filter;
+
 namespace detail{
 
 #if defined(BOOST_MSVC)
@@ -60,47 +70,6 @@ namespace detail{
 #pragma warning(disable:4714) /* marked as __forceinline not inlined */
 #endif
 
-/*  mcg_and_fastrange produces (pos,hash') from hash, where
- *   - m=mulx64(hash,range), mulx64 denotes extended multiplication
- *   - pos=high(m)
- *   - hash'=low(m)
- *  pos is uniformly distributed in [0,range) (see
- *  https://arxiv.org/pdf/1805.10941), whereas hash'<-hash is a multiplicative
- *  congruential generator of the form hash'<-hash*rng mod 2^64. This MCG
- *  generates long cycles when the initial value of hash is odd and
- *  rng = +-3 (mod 8), which is why we adjust hash and rng as seen below. As a
- *  result, the low bits of hash' are of poor quality, and the least
- *  significant bit in particular is always one.
- */
-
-struct mcg_and_fastrange
-{
-  constexpr mcg_and_fastrange(std::size_t m)noexcept:
-    rng{
-      m+(
-        (m%8<=3)?3-(m%8):
-        (m%8<=5)?5-(m%8):
-                 8-(m%8)+3)
-    }
-    {}
-
-  inline constexpr std::size_t range()const noexcept{return (std::size_t)rng;}
-
-  inline void prepare_hash(boost::uint64_t& hash)const noexcept
-  {
-    hash|=1u;
-  }
-
-  inline std::size_t next_position(boost::uint64_t& hash)const noexcept
-  {
-    boost::uint64_t hi;
-    hash=umul128(hash,rng,hi);
-    return (std::size_t)hi;
-  }
-
-  boost::uint64_t rng;
-};
-
 /* used_value_size<Subfilter>::value is Subfilter::used_value_size if it
  * exists, or sizeof(Subfilter::value_type) otherwise. This covers the
  * case where a subfilter only operates on the first bytes of its entire
@@ -122,6 +91,71 @@ struct used_value_size<
   static constexpr std::size_t value=Subfilter::used_value_size;
 };
 
+/* allocation_alignment<Allocator>::value is Allocator::alignment if it
+ * exists, meaning that allocate always returns memory aligned to it, or 1
+ * otherwise.
+ */
+
+template<typename Allocator,typename=void>
+struct allocation_alignment
+{
+  static constexpr std::size_t value=1;
+};
+
+template<typename Allocator>
+struct allocation_alignment<
+  Allocator,
+  typename std::enable_if<Allocator::alignment!=0>::type
+>
+{
+  static constexpr std::size_t value=Allocator::alignment;
+};
+
+/* is_foldable<HashStrategy>::value is HashStrategy::foldable if it exists,
+ * or false otherwise.
+ */
+
+template<typename HashStrategy,typename=void>
+struct is_foldable:std::false_type{};
+
+template<typename HashStrategy>
+struct is_foldable<
+  HashStrategy,
+  typename std::enable_if<HashStrategy::foldable>::type
+>:std::true_type{};
+
+/* range of a filter with range rng folded levels times */
+
+inline std::size_t folded_range(std::size_t rng,std::size_t levels)
+{
+  if(levels>=(std::size_t)std::numeric_limits<std::size_t>::digits||
+     (rng>>levels)==0){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("too many fold levels"));
+  }
+  return rng>>levels;
+}
+
+/* ORs each group of 2^levels consecutive buckets of src, with rng buckets,
+ * into one bucket of dst, which must be zeroed beforehand. When buckets
+ * overlap (BucketSize<UsedValueSize), so do their destinations, and
+ * every byte of dst ends up as the OR of all the bytes folded into it.
+ */
+
+template<std::size_t BucketSize,std::size_t UsedValueSize>
+void fold_array(
+  unsigned char* dst,const unsigned char* src,
+  std::size_t rng,std::size_t levels)
+{
+  std::size_t n=std::size_t(1)<<levels;
+  for(std::size_t j=0;j<(rng>>levels);++j){
+    auto q=dst+j*BucketSize;
+    for(auto p=src+j*n*BucketSize,last=p+n*BucketSize;p!=last;
+        p+=BucketSize){
+      for(std::size_t i=0;i<UsedValueSize;++i)q[i]|=p[i];
+    }
+  }
+}
+
 /* GCD with x,p > 1, p a power of two */
 
 inline constexpr std::size_t gcd_pow2(std::size_t x,std::size_t p)
@@ -143,6 +177,14 @@ struct filter_array
   unsigned char* buckets; /* adjusted from data for proper alignment */
 };
 
+/* tag for construction over a non-owned, read-only array, and allocator
+ * that must be used in that case (defined in filter_view.hpp)
+ */
+
+struct external_array_t{};
+
+template<typename T> struct external_array_allocator;
+
 struct if_constexpr_void_else{void operator()()const{}};
 
 template<bool B,typename F,typename G=if_constexpr_void_else>
@@ -170,7 +212,14 @@ template<bool B,typename T,typename std::enable_if<!B>::type* =nullptr>
 void swap_if(T&,T&){}
 
 template<
-  std::size_t K,typename Subfilter,std::size_t BucketSize,typename Allocator
+  std::size_t K,typename Subfilter,std::size_t BucketSize,
+  std::size_t CounterBits,typename Allocator,typename HashStrategy
+>
+class counting_core;
+
+template<
+  std::size_t K,typename Subfilter,std::size_t BucketSize,typename Allocator,
+  typename HashStrategy=mcg_and_fastrange
 >
 class filter_core:empty_value<Allocator,0>
 {
@@ -182,6 +231,7 @@ class filter_core:empty_value<Allocator,0>
 public:
   static constexpr std::size_t k=K;
   using subfilter=Subfilter;
+  using hash_strategy=HashStrategy;
 
 private:
   static constexpr std::size_t kp=subfilter::k;
@@ -208,9 +258,14 @@ private:
       1;
   static constexpr std::size_t prefetched_cachelines=
     1+(block_size+cacheline-1-gcd_pow2(bucket_size,cacheline))/cacheline;
-  using hash_strategy=detail::mcg_and_fastrange;
 
 public:
+  /* maximum number of elements processed in one go by bulk operations */
+  static constexpr std::size_t bulk_lookup_size=16;
+
+  /* number of elements simultaneously in flight in bulk insertion */
+  static constexpr std::size_t bulk_insert_size=32;
+
   using allocator_type=Allocator;
   using size_type=std::size_t;
   using difference_type=std::ptrdiff_t;
@@ -360,6 +415,59 @@ public:
     return m==0?1.0:n==0?0.0:fpr_for_c((double)m/n);
   }
 
+  double fill_ratio()const noexcept
+  {
+    if(!ar.data)return 0.0;
+    return
+      (double)bitwise_popcount(ar.buckets,used_array_size())/capacity();
+  }
+
+  /* Inverts the expected fill ratio after n insertions,
+   *
+   *   1 - (1 - d/m)^(k*n),
+   *
+   * where m is the number of bits spanned by bucket positions (capacity
+   * minus the tail of the last subarray) and d is the expected number of
+   * distinct bits set by the subfilter on a mark operation (less than
+   * subfilter::k for block when bits collide).
+   */
+
+  double estimated_size()const noexcept
+  {
+    if(!ar.data)return 0.0;
+    return estimated_size_for(
+      bitwise_popcount(ar.buckets,used_array_size()));
+  }
+
+  double estimated_fpr()const noexcept
+  {
+    if(!ar.data)return 1.0;
+    double n=estimated_size();
+    if(n==0.0)return 0.0;
+    if(n==std::numeric_limits<double>::infinity())return 1.0;
+    return fpr_for_c((double)capacity()/n);
+  }
+
+  /* Sizes of *this, x and their union are estimated from the popcounts of
+   * *this, x and *this|x, calculated in one pass; the intersection size
+   * follows as size(*this) + size(x) - size(union).
+   */
+
+  double estimated_intersection_size(const filter_core& x)const
+  {
+    return estimate_cardinalities(x).intersection();
+  }
+
+  double estimated_union_size(const filter_core& x)const
+  {
+    return estimate_cardinalities(x).u;
+  }
+
+  double jaccard_index(const filter_core& x)const
+  {
+    return estimate_cardinalities(x).jaccard_index();
+  }
+
   boost::span<unsigned char> array()noexcept
   {
     return {ar.data?ar.buckets:nullptr,capacity()/CHAR_BIT};
@@ -385,6 +493,260 @@ public:
     }
   }
 
+  /* Bulk insertion of the hashes provided by gen, which is called as
+   * gen(hash) and returns false when there are no more hashes. Elements are
+   * kept in a ring of bulk_insert_size slots, each holding the hash and
+   * prefetched bucket of an element along with its remaining number of
+   * marking rounds: visiting a slot marks one bucket and prefetches the next
+   * (or that of a newly generated element), so that the prefetch has the
+   * rest of the ring to complete before the slot is visited again. As
+   * marking is an OR operation, the resulting array is identical to that of
+   * sequential insertion.
+   */
+
+  template<typename HashGenerator>
+  void bulk_insert(HashGenerator gen)
+  {
+    static constexpr std::size_t N=bulk_insert_size;
+    static_assert((N&(N-1))==0,"bulk_insert_size must be a power of two");
+
+    if(BOOST_UNLIKELY(ar.data==nullptr))return;
+
+    boost::uint64_t hashes[N];
+    unsigned char*  ps[N];
+    std::size_t     rounds[N]={};
+    std::size_t     num_live=0;
+
+    for(;num_live<N&&gen(hashes[num_live]);++num_live){
+      hs.prepare_hash(hashes[num_live]);
+      ps[num_live]=next_element(hashes[num_live]);
+      rounds[num_live]=k;
+    }
+    if(num_live==N){
+      for(std::size_t i=0;;i=(i+1)&(N-1)){
+        set(ps[i],hashes[i]);
+        if(--rounds[i])ps[i]=next_element(hashes[i]);
+        else if(gen(hashes[i])){
+          hs.prepare_hash(hashes[i]);
+          ps[i]=next_element(hashes[i]);
+          rounds[i]=k;
+        }
+        else{
+          --num_live;
+          break;
+        }
+      }
+    }
+    while(num_live){
+      for(std::size_t i=0;i<N;++i){
+        if(!rounds[i])continue;
+        set(ps[i],hashes[i]);
+        if(--rounds[i])ps[i]=next_element(hashes[i]);
+        else --num_live;
+      }
+    }
+  }
+
+  /* Bulk insertion for arrays much larger than the cache. For a batch of
+   * elements, the hash states preceding each of the k rounds of insertion
+   * are recorded (a state uniquely determines the position and hash used
+   * in its round), and then sorted by position with an LSD radix sort on
+   * the (up to 16) most significant bits of the position, so that writes
+   * are applied sweeping the array in ascending order, one small region at
+   * a time. This keeps cache and TLB misses low when the batch is large
+   * compared to the number of regions. For arrays smaller than
+   * partitioned_insert_min_size, bulk_insert is used instead. The
+   * resulting array is identical to that of sequential insertion.
+   */
+
+  static constexpr std::size_t partitioned_insert_min_size=
+    std::size_t(1)<<24;
+  static constexpr std::size_t partitioned_insert_batch_size=
+    std::size_t(1)<<22; /* hash states per batch */
+
+  template<typename HashGenerator>
+  void partitioned_insert(HashGenerator gen)
+  {
+    static constexpr int max_key_bits=16;
+    static constexpr int region_bits=
+      (int)constexpr_bit_width((std::size_t(1)<<18)/bucket_size)-1;
+
+    if(BOOST_UNLIKELY(ar.data==nullptr))return;
+    if(used_array_size()<partitioned_insert_min_size){
+      bulk_insert(gen);
+      return;
+    }
+
+    int position_bits=(int)constexpr_bit_width(range()-1);
+    int key_bits=position_bits-region_bits;
+    if(key_bits<=0){
+      bulk_insert(gen);
+      return;
+    }
+    if(key_bits>max_key_bits)key_bits=max_key_bits;
+    int num_passes=(key_bits+7)/8;
+    int digit_bits=(key_bits+num_passes-1)/num_passes;
+    int shift=position_bits-key_bits;
+
+    /* scratch memory is capped by the size of the array */
+    std::size_t    N=(std::min)(
+      partitioned_insert_batch_size,used_array_size()/16)/k;
+    if(!N)N=1;
+    scratch_buffer buf{al(),2*N*k};
+    auto           first0=buf.data,first1=buf.data+N*k;
+    for(;;){
+      auto            last0=first0;
+      boost::uint64_t hash;
+      for(std::size_t i=0;i<N&&gen(hash);++i){
+        hs.prepare_hash(hash);
+        for(auto n=k;n--;){
+          *last0++=hash;
+          hs.next_position(hash);
+        }
+      }
+      if(last0==first0)break;
+
+      for(int pass=0;pass<num_passes;++pass){
+        radix_pass(first0,last0,first1,shift+pass*digit_bits,digit_bits);
+        last0=first1+(last0-first0);
+        std::swap(first0,first1);
+      }
+
+      static constexpr std::ptrdiff_t prefetch_distance=32;
+      for(auto it=first0;it!=last0;++it){
+        if(last0-it>prefetch_distance){
+          auto h=it[prefetch_distance];
+          BOOST_BLOOM_PREFETCH_WRITE(
+            ar.buckets+hs.next_position(h)*bucket_size);
+        }
+        auto h=*it;
+        auto p=ar.buckets+hs.next_position(h)*bucket_size;
+        set(p,h);
+      }
+    }
+  }
+
+  /* Parallel insertion of hash_at(i), i in [0,n), with executor ex (see
+   * <boost/bloom/detail/parallel.hpp>). As in partitioned_insert, the hash
+   * states of the k rounds of a batch of elements are recorded and then
+   * distributed by region of the array with a counting sort on the most
+   * significant bits of their positions, both steps being done in parallel
+   * over chunks of the batch. Regions are then marked in parallel without
+   * synchronization: if blocks extend past their bucket, so that adjacent
+   * regions may share some bytes, even and odd regions are marked in two
+   * successive passes (note that subfilter::mark may write to the entire
+   * block even if used_value_size is smaller). The resulting array is
+   * identical to that of sequential insertion.
+   */
+
+  static constexpr std::size_t parallel_insert_chunk_size=
+    std::size_t(1)<<14; /* hash states per chunk */
+
+  template<typename HashAt,typename Executor>
+  void parallel_insert(std::size_t n,HashAt hash_at,Executor& ex)
+  {
+    static constexpr int max_region_key_bits=10;
+    static constexpr int min_region_bits=
+      (int)constexpr_bit_width((block_size-1)/bucket_size);
+    static constexpr std::size_t C=parallel_insert_chunk_size;
+
+    if(BOOST_UNLIKELY(ar.data==nullptr))return;
+
+    int position_bits=(int)constexpr_bit_width(range()-1);
+    int shift=(std::max)(
+      position_bits-max_region_key_bits,min_region_bits);
+    if(n*k<=C||shift>=position_bits){
+      std::size_t i=0;
+      bulk_insert([&](boost::uint64_t& hash)->bool{
+        if(i==n)return false;
+        hash=hash_at(i++);
+        return true;
+      });
+      return;
+    }
+
+    std::size_t        num_regions=((range()-1)>>shift)+1,
+                       batch_size=(std::min)(
+                         partitioned_insert_batch_size/k,n),
+                       chunk_size=(std::max)(C/k,std::size_t(1)),
+                       max_chunks=(batch_size+chunk_size-1)/chunk_size;
+    scratch_buffer     buf{al(),2*batch_size*k};
+    scratch_buffer     counts{al(),max_chunks*num_regions+num_regions+1};
+    auto               states=buf.data,sorted_states=buf.data+batch_size*k;
+    auto               region_starts=counts.data+max_chunks*num_regions;
+    for(std::size_t first=0;first<n;first+=batch_size){
+      std::size_t m=(std::min)(batch_size,n-first),
+                  num_chunks=(m+chunk_size-1)/chunk_size;
+
+      ex(num_chunks,[&,this](std::size_t j){
+        auto cnt=counts.data+j*num_regions;
+        auto out=states+j*chunk_size*k;
+        std::fill(cnt,cnt+num_regions,boost::uint64_t(0));
+        for(std::size_t i=j*chunk_size,
+            last=(std::min)(i+chunk_size,m);i<last;++i){
+          boost::uint64_t hash=hash_at(first+i);
+          hs.prepare_hash(hash);
+          for(auto r=k;r--;){
+            *out++=hash;
+            ++cnt[hs.next_position(hash)>>shift];
+          }
+        }
+      });
+
+      /* counts become the positions where each chunk writes its states
+       * for each region
+       */
+
+      boost::uint64_t acc=0;
+      for(std::size_t r=0;r<num_regions;++r){
+        region_starts[r]=acc;
+        for(std::size_t j=0;j<num_chunks;++j){
+          auto& cnt=counts.data[j*num_regions+r];
+          auto  c=cnt;
+          cnt=acc;
+          acc+=c;
+        }
+      }
+      region_starts[num_regions]=acc;
+
+      ex(num_chunks,[&,this](std::size_t j){
+        auto cnt=counts.data+j*num_regions;
+        auto it=states+j*chunk_size*k,
+             last=states+(std::min)((j+1)*chunk_size,m)*k;
+        for(;it!=last;++it){
+          auto h=*it;
+          sorted_states[cnt[hs.next_position(h)>>shift]++]=*it;
+        }
+      });
+
+      auto mark_region=[&,this](std::size_t r){
+        static constexpr std::ptrdiff_t prefetch_distance=32;
+        auto it=sorted_states+region_starts[r],
+             last=sorted_states+region_starts[r+1];
+        for(;it!=last;++it){
+          if(last-it>prefetch_distance){
+            auto h=it[prefetch_distance];
+            BOOST_BLOOM_PREFETCH_WRITE(
+              ar.buckets+hs.next_position(h)*bucket_size);
+          }
+          auto h=*it;
+          auto p=ar.buckets+hs.next_position(h)*bucket_size;
+          set(p,h);
+        }
+      };
+      if(block_size==bucket_size){
+        ex(num_regions,mark_region);
+      }
+      else{
+        for(std::size_t parity=0;parity<2;++parity){
+          ex((num_regions+1-parity)/2,[&](std::size_t i){
+            mark_region(2*i+parity);
+          });
+        }
+      }
+    }
+  }
+
   void swap(filter_core& x)noexcept(
     allocator_propagate_on_container_swap_t<allocator_type>::value||
     allocator_is_always_equal_t<allocator_type>::value)
@@ -426,18 +788,84 @@ public:
     reset(capacity_for(n,fpr));
   }
 
+  /* Halves the range levels times by ORing together groups of 2^levels
+   * consecutive buckets. With a foldable hash strategy, elements are
+   * mapped to the same buckets divided by 2^levels with the same hash
+   * values, so the result is identical to inserting the elements into a
+   * filter with the folded capacity, or a superset thereof if buckets
+   * overlap.
+   */
+
+  void fold(std::size_t levels=1)
+  {
+    static_assert(
+      is_foldable<hash_strategy>::value,
+      "the hash strategy doesn't support folding");
+
+    if(!ar.data||levels==0)return;
+    std::size_t rng=folded_range(range(),levels);
+    auto        new_ar=new_array(al(),rng);
+    std::memset(new_ar.buckets,0,used_array_size(rng));
+    fold_array<bucket_size,used_value_size>(
+      new_ar.buckets,ar.buckets,range(),levels);
+    delete_array();
+    hs=hash_strategy{rng};
+    ar=new_ar;
+  }
+
   filter_core& operator&=(const filter_core& x)
   {
-    combine(x,[](unsigned char& a,unsigned char b){a&=b;});
+    combine<and_op>(x);
     return *this;
   }
 
   filter_core& operator|=(const filter_core& x)
   {
-    combine(x,[](unsigned char& a,unsigned char b){a|=b;});
+    combine<or_op>(x);
+    return *this;
+  }
+
+  filter_core& operator^=(const filter_core& x)
+  {
+    combine<xor_op>(x);
+    return *this;
+  }
+
+  filter_core& operator-=(const filter_core& x)
+  {
+    combine<and_not_op>(x);
     return *this;
   }
 
+  /* Combines *this with all the filters in [first,last) (accessed through
+   * get) in one pass: the array is processed in chunks small enough to
+   * remain in L1 cache while all the sources are applied to it, so that
+   * its memory is read and written only once.
+   */
+
+  template<typename Op,typename FilterIterator,typename Get>
+  void multi_combine(FilterIterator first,FilterIterator last,Get get)
+  {
+    for(auto it=first;it!=last;++it){
+      if(range()!=get(*it).range()){
+        BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
+      }
+    }
+    std::size_t n=used_array_size();
+    for(std::size_t i=0;i<n;i+=combine_chunk_size){
+      std::size_t m=(std::min)(combine_chunk_size,n-i);
+      for(auto it=first;it!=last;++it){
+        bitwise_assign<Op>(ar.buckets+i,get(*it).ar.buckets+i,m);
+      }
+    }
+  }
+
+  bool is_subset_of(const filter_core& x)const
+  {
+    if(range()!=x.range())return false;
+    return bitwise_is_subset(ar.buckets,x.ar.buckets,used_array_size());
+  }
+
   BOOST_FORCEINLINE bool may_contain(boost::uint64_t hash)const
   {
     hs.prepare_hash(hash);
@@ -460,6 +888,95 @@ public:
 #endif
   }
 
+  /* Bulk lookup of n<=bulk_lookup_size hashes (which are modified). The first
+   * buckets of all the elements are prefetched before any of them is
+   * checked, so that up to n cache misses are in flight simultaneously. The
+   * remaining k-1 rounds proceed in lockstep over the elements still
+   * testing positive, which are kept in a compacted list to avoid
+   * branching on the result of each check. For k==1, if the subfilter has
+   * a batch_check kernel, elements are checked in groups of its width
+   * (measurements show no gain from the kernel when k>1).
+   */
+
+  void bulk_may_contain(boost::uint64_t* hashes,std::size_t n,bool* res)const
+  {
+    BOOST_ASSERT(n<=bulk_lookup_size);
+
+    const unsigned char* ps[bulk_lookup_size];
+    std::size_t          live[bulk_lookup_size];
+    std::size_t          num_live=n;
+
+    for(std::size_t i=0;i<n;++i){
+      hs.prepare_hash(hashes[i]);
+      ps[i]=next_element(hashes[i]);
+      live[i]=i;
+    }
+    if(k==1){
+      std::size_t i=0;
+      if(batch_width>0){
+        for(;i+batch_width<=n;i+=batch_width){
+          batch_get(ps+i,hashes+i,res+i);
+        }
+      }
+      for(;i<n;++i)res[i]=get(ps[i],hashes[i]);
+      return;
+    }
+    for(std::size_t r=k;r--;){
+      std::size_t m=0;
+      for(std::size_t j=0;j<num_live;++j){
+        auto i=live[j];
+        auto p=ps[i];
+        auto hash=hashes[i];
+        if(r)ps[i]=next_element(hashes[i]); /* prefetch for next round */
+        res[i]=get(p,hash);
+        live[m]=i;
+        m+=res[i];
+      }
+      num_live=m;
+    }
+  }
+
+  /* Insertion and lookup split into a first stage, which prepares hash and
+   * prefetches the first bucket, and a second stage doing the rest of the
+   * operation with the p and hash obtained in the first stage. This allows
+   * for operations on several filters to be interleaved.
+   */
+
+  BOOST_FORCEINLINE unsigned char* prepare_insert(boost::uint64_t& hash)
+  {
+    hs.prepare_hash(hash);
+    return next_element(hash);
+  }
+
+  BOOST_FORCEINLINE void resume_insert(unsigned char* p,boost::uint64_t hash)
+  {
+    if(BOOST_UNLIKELY(ar.data==nullptr))return;
+    for(auto n=k;;){
+      set(p,hash);
+      if(!--n)break;
+      p=next_element(hash);
+    }
+  }
+
+  BOOST_FORCEINLINE
+  const unsigned char* prepare_may_contain(boost::uint64_t& hash)const
+  {
+    hs.prepare_hash(hash);
+    return next_element(hash);
+  }
+
+  BOOST_FORCEINLINE bool resume_may_contain(
+    const unsigned char* p,boost::uint64_t hash)const
+  {
+    for(std::size_t n=k-1;n--;){
+      auto p0=p;
+      auto hash0=hash;
+      p=next_element(hash);
+      if(!get(p0,hash0))return false;
+    }
+    return get(p,hash);
+  }
+
   friend bool operator==(const filter_core& x,const filter_core& y)
   {
     if(x.range()!=y.range())return false;
@@ -468,11 +985,53 @@ public:
   }
 
 private:
+  template<
+    std::size_t K1,typename Subfilter1,std::size_t BucketSize1,
+    std::size_t CounterBits1,typename Allocator1,typename HashStrategy1
+  >
+  friend class counting_core;
+
+  template<
+    typename T1,std::size_t K1,typename Subfilter1,std::size_t BucketSize1,
+    typename Hash1,typename Allocator1,typename HashStrategy1
+  >
+  friend class boost::bloom::filter;
+
   using allocator_base=empty_value<Allocator,0>;
 
   const Allocator& al()const{return allocator_base::get();}
   Allocator& al(){return allocator_base::get();}
 
+  /* Read-only view over [p,p+m/CHAR_BIT) (plus the bytes beyond
+   * used_value_size of the last block, which lookups may read). Only
+   * const member functions can be used, so this is reserved to filter_view
+   * through filter.
+   */
+
+  filter_core(const unsigned char* p,std::size_t m,external_array_t):
+    allocator_base{empty_init,allocator_type{}},
+    hs{requested_range(m)},
+    ar(new_array(al(),0))
+  {
+    static_assert(
+      std::is_same<
+        allocator_type,external_array_allocator<unsigned char>>::value,
+      "external arrays require detail::external_array_allocator");
+
+    static constexpr std::size_t required_alignment=
+      are_blocks_aligned?alignof(block_type):1;
+
+    if(m==0)return;
+    if(used_array_size(hs.range())*CHAR_BIT!=m){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("invalid capacity"));
+    }
+    if(!p||boost::uintptr_t(p)%required_alignment!=0){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("misaligned array"));
+    }
+    auto q=const_cast<unsigned char*>(p);
+    ar={q,q};
+  }
+
   static std::size_t requested_range(std::size_t m)
   {
     if(m>(used_value_size-bucket_size)*CHAR_BIT){
@@ -489,6 +1048,7 @@ private:
   {
     if(rng){
       auto p=allocator_allocate(al,space_for(rng));
+      BOOST_ASSERT(alignment_padding!=0||buckets_for(p)==p);
       return {p,buckets_for(p)};
     }
     else{
@@ -500,7 +1060,9 @@ private:
        */
 
       static struct {unsigned char x=-1;}
-      dummy[space_for(hash_strategy{0}.range())];
+      dummy[
+        (initial_alignment-1)+
+        hash_strategy{0}.range()*bucket_size+tail_size];
 
       return {nullptr,buckets_for(reinterpret_cast<unsigned char*>(&dummy))};
     }
@@ -522,14 +1084,101 @@ private:
     std::memcpy(ar.buckets,x.ar.buckets,used_array_size());
   }
 
+  static constexpr std::size_t batch_width=batch_check<subfilter>::width;
+
+  /* res[i]=get(ps[i],hashes[i]) for i<batch_width */
+
+  BOOST_FORCEINLINE void batch_get(
+    const unsigned char* const* ps,const boost::uint64_t* hashes,
+    bool* res)const
+  {
+    static constexpr std::size_t W=batch_width?batch_width:1;
+
+    boost::uint64_t offsets[W];
+    for(std::size_t i=0;i<W;++i){
+      offsets[i]=(boost::uint64_t)(ps[i]-ar.buckets);
+    }
+    int mask=batch_check_for(ar.buckets,offsets,hashes);
+    for(std::size_t i=0;i<W;++i)res[i]=(mask>>i)&1;
+  }
+
+  template<
+    typename Subfilter_=subfilter,
+    typename std::enable_if<batch_check<Subfilter_>::width!=0>::type* =nullptr
+  >
+  static BOOST_FORCEINLINE int batch_check_for(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    return batch_check<Subfilter_>::check(base,offsets,hashes);
+  }
+
+  template<
+    typename Subfilter_=subfilter,
+    typename std::enable_if<batch_check<Subfilter_>::width==0>::type* =nullptr
+  >
+  static BOOST_FORCEINLINE int batch_check_for(
+    const unsigned char*,const boost::uint64_t*,const boost::uint64_t*)
+  {
+    return 0; /* never called */
+  }
+
+  struct scratch_buffer
+  {
+    using allocator_type=allocator_rebind_t<Allocator,boost::uint64_t>;
+
+    scratch_buffer(const Allocator& al_,std::size_t n_):
+      al{al_},n{n_},data{allocator_allocate(al,n)}{}
+    scratch_buffer(const scratch_buffer&)=delete;
+    scratch_buffer& operator=(const scratch_buffer&)=delete;
+    ~scratch_buffer(){allocator_deallocate(al,data,n);}
+
+    allocator_type   al;
+    std::size_t      n;
+    boost::uint64_t* data;
+  };
+
+  /* stable counting sort of hash states by the digit_bits-wide digit at
+   * position shift of their associated positions
+   */
+
+  void radix_pass(
+    const boost::uint64_t* first,const boost::uint64_t* last,
+    boost::uint64_t* res,int shift,int digit_bits)const
+  {
+    static constexpr std::size_t max_num_digits=256;
+
+    std::size_t mask=(std::size_t(1)<<digit_bits)-1;
+    std::size_t offsets[max_num_digits]={};
+    auto        digit=[&,this](boost::uint64_t h){
+      return (hs.next_position(h)>>shift)&mask;
+    };
+
+    BOOST_ASSERT(mask<max_num_digits);
+    for(auto it=first;it!=last;++it)++offsets[digit(*it)];
+    std::size_t acc=0;
+    for(auto& offset:offsets){
+      auto count=offset;
+      offset=acc;
+      acc+=count;
+    }
+    for(auto it=first;it!=last;++it)res[offsets[digit(*it)]++]=*it;
+  }
+
   std::size_t range()const noexcept
   {
     return ar.data?hs.range():0;
   }
 
+  /* no padding is needed if the allocator already aligns memory */
+
+  static constexpr std::size_t alignment_padding=
+    allocation_alignment<Allocator>::value%initial_alignment==0?
+      0:initial_alignment-1;
+
   static constexpr std::size_t space_for(std::size_t rng)noexcept
   {
-    return (initial_alignment-1)+rng*bucket_size+tail_size;
+    return alignment_padding+rng*bucket_size+tail_size;
   }
 
   static unsigned char* buckets_for(unsigned char* p)noexcept
@@ -702,16 +1351,59 @@ private:
     return p;
   }
 
-  template<typename F>
-  void combine(const filter_core& x,F f)
+  double estimated_size_for(std::size_t popcount)const noexcept
+  {
+    if(popcount==0)return 0.0;
+    if(popcount==capacity())return std::numeric_limits<double>::infinity();
+
+    double fill=(double)popcount/capacity(),
+           m=(double)(range()*bucket_size*CHAR_BIT),
+           d=subfilter::marked_bits(used_value_size*CHAR_BIT);
+    return std::log(1.0-fill)/(k*std::log(1.0-d/m));
+  }
+
+  struct cardinalities
+  {
+    double intersection()const
+    {
+      if(u==std::numeric_limits<double>::infinity())return (std::min)(a,b);
+      return (std::max)(0.0,a+b-u);
+    }
+
+    double jaccard_index()const
+    {
+      if(u==0.0)return 1.0;
+      if(u==std::numeric_limits<double>::infinity()){
+        return (std::min)(a,b)==u?1.0:0.0;
+      }
+      return (std::min)(1.0,intersection()/u);
+    }
+
+    double a,b,u; /* sizes of *this, x and their union */
+  };
+
+  cardinalities estimate_cardinalities(const filter_core& x)const
+  {
+    if(range()!=x.range()){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
+    }
+    std::size_t res[3];
+    bitwise_popcounts<left_op,right_op,or_op>(
+      ar.buckets,x.ar.buckets,used_array_size(),res);
+    return {
+      estimated_size_for(res[0]),estimated_size_for(res[1]),
+      estimated_size_for(res[2])};
+  }
+
+  static constexpr std::size_t combine_chunk_size=4096;
+
+  template<typename Op>
+  void combine(const filter_core& x)
   {
     if(range()!=x.range()){
       BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
     }
-    auto first0=ar.buckets,
-         last0=first0+used_array_size(),
-         first1=x.ar.buckets;
-    while(first0!=last0)f(*first0++,*first1++);
+    bitwise_assign<Op>(ar.buckets,x.ar.buckets,used_array_size());
   }
 
   hash_strategy hs;
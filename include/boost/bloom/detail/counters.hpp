@@ -0,0 +1,364 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COUNTERS_HPP
+#define BOOST_BLOOM_DETAIL_COUNTERS_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Arrays of saturating counters of CounterBits bits (4 or 8) paired with
+ * the bits of a bit array: counter 8*i+j stands for bit j of byte i, and
+ * 4-bit counters are packed two per byte, the even one in the low nibble.
+ * Operations take a pointer p to the counters of the first bit of a byte
+ * range and a mask fp of n bytes selecting the counters affected:
+ *
+ *   - increment adds one to the selected counters, except those already
+ *     at their maximum value, which stay saturated for ever.
+ *   - decrement subtracts one from the selected counters, except those
+ *     saturated or zero.
+ *   - check returns whether all the selected counters are non-zero.
+ *
+ * to_bits(p,out,n) sets each bit of out[0,n) iff its counter is non-zero.
+ * Without SIMD, the set bits of the mask are visited 64 at a time with
+ * countr_zero. With AVX2, masks are processed 256 counters at a time,
+ * expanding their bits into byte (or nibble) masks, and portions of the
+ * mask that are zero (e.g. words not touched in a multiblock) are skipped.
+ */
+
+/* first min(n,8) bytes of p as a 64-bit word, byte i going to bits
+ * [8*i,8*i+8) regardless of endianness
+ */
+
+inline boost::uint64_t load_word(const unsigned char* p,std::size_t n)
+{
+  boost::uint64_t w=0;
+  for(std::size_t i=0;i<n&&i<8;++i)w|=(boost::uint64_t)p[i]<<(8*i);
+  return w;
+}
+
+template<std::size_t CounterBits>
+struct counter_ops;
+
+template<>
+struct counter_ops<8>
+{
+  static constexpr std::size_t counter_bits=8;
+
+  static BOOST_FORCEINLINE void increment(
+    unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+4<=n;i+=4,p+=32){
+      boost::uint32_t m;
+      std::memcpy(&m,fp+i,4);
+      if(!m)continue;
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      c=_mm256_adds_epu8(c,_mm256_and_si256(expand(m),one()));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),c);
+    }
+#endif
+    for(;i<n;i+=8,p+=64){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        auto& c=p[boost::core::countr_zero(w)];
+        c+=(c!=0xFFu);
+      }
+    }
+  }
+
+  static BOOST_FORCEINLINE void decrement(
+    unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+4<=n;i+=4,p+=32){
+      boost::uint32_t m;
+      std::memcpy(&m,fp+i,4);
+      if(!m)continue;
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      __m256i d=_mm256_andnot_si256(
+        _mm256_cmpeq_epi8(c,_mm256_set1_epi8(-1)),
+        _mm256_and_si256(expand(m),one()));
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(p),_mm256_subs_epu8(c,d));
+    }
+#endif
+    for(;i<n;i+=8,p+=64){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        auto& c=p[boost::core::countr_zero(w)];
+        c-=(c!=0xFFu&&c!=0);
+      }
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(
+    const unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+4<=n;i+=4,p+=32){
+      boost::uint32_t m;
+      std::memcpy(&m,fp+i,4);
+      if(!m)continue;
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      if(!_mm256_testz_si256(
+        _mm256_cmpeq_epi8(c,_mm256_setzero_si256()),expand(m))){
+        return false;
+      }
+    }
+#endif
+    for(;i<n;i+=8,p+=64){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        if(!p[boost::core::countr_zero(w)])return false;
+      }
+    }
+    return true;
+  }
+
+  static void to_bits(const unsigned char* p,unsigned char* out,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+4<=n;i+=4,p+=32){
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      boost::uint32_t m=~(boost::uint32_t)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(c,_mm256_setzero_si256()));
+      std::memcpy(out+i,&m,4);
+    }
+#endif
+    for(;i<n;++i,p+=8){
+      unsigned int b=0;
+      for(int j=0;j<8;++j)b|=(unsigned int)(p[j]!=0)<<j;
+      out[i]=(unsigned char)b;
+    }
+  }
+
+private:
+#if defined(BOOST_BLOOM_AVX2)
+  static BOOST_FORCEINLINE __m256i one()
+  {
+    return _mm256_set1_epi8(1);
+  }
+
+  /* byte j set to 0xFF iff bit j of m is set */
+
+  static BOOST_FORCEINLINE __m256i expand(boost::uint32_t m)
+  {
+    const __m256i shuffle=_mm256_setr_epi8(
+      0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,
+      2,2,2,2,2,2,2,2,3,3,3,3,3,3,3,3);
+    const __m256i bits=_mm256_set1_epi64x(
+      (long long)0x8040201008040201ull);
+
+    __m256i v=_mm256_shuffle_epi8(_mm256_set1_epi32((int)m),shuffle);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(v,bits),bits);
+  }
+#endif
+};
+
+template<>
+struct counter_ops<4>
+{
+  static constexpr std::size_t counter_bits=4;
+
+  static BOOST_FORCEINLINE void increment(
+    unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+8<=n;i+=8,p+=32){
+      boost::uint64_t m;
+      std::memcpy(&m,fp+i,8);
+      if(!m)continue;
+      __m256i lo_sel,hi_sel;
+      expand(m,lo_sel,hi_sel);
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),
+              lo=_mm256_and_si256(c,lo_nibbles()),
+              hi=_mm256_and_si256(c,hi_nibbles());
+      __m256i inc=_mm256_or_si256(
+        _mm256_andnot_si256(
+          _mm256_cmpeq_epi8(lo,lo_nibbles()),
+          _mm256_and_si256(lo_sel,_mm256_set1_epi8(0x01))),
+        _mm256_andnot_si256(
+          _mm256_cmpeq_epi8(hi,hi_nibbles()),
+          _mm256_and_si256(hi_sel,_mm256_set1_epi8(0x10))));
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(p),_mm256_add_epi8(c,inc));
+    }
+#endif
+    for(;i<n;i+=8,p+=32){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        int  j=boost::core::countr_zero(w);
+        auto s=(j&1)*4;
+        auto& c=p[j>>1];
+        if(((c>>s)&0x0Fu)!=0x0Fu)c=(unsigned char)(c+(1u<<s));
+      }
+    }
+  }
+
+  static BOOST_FORCEINLINE void decrement(
+    unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+8<=n;i+=8,p+=32){
+      boost::uint64_t m;
+      std::memcpy(&m,fp+i,8);
+      if(!m)continue;
+      __m256i lo_sel,hi_sel;
+      expand(m,lo_sel,hi_sel);
+      const __m256i zero=_mm256_setzero_si256();
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),
+              lo=_mm256_and_si256(c,lo_nibbles()),
+              hi=_mm256_and_si256(c,hi_nibbles());
+      __m256i dec=_mm256_or_si256(
+        _mm256_andnot_si256(
+          _mm256_or_si256(
+            _mm256_cmpeq_epi8(lo,lo_nibbles()),_mm256_cmpeq_epi8(lo,zero)),
+          _mm256_and_si256(lo_sel,_mm256_set1_epi8(0x01))),
+        _mm256_andnot_si256(
+          _mm256_or_si256(
+            _mm256_cmpeq_epi8(hi,hi_nibbles()),_mm256_cmpeq_epi8(hi,zero)),
+          _mm256_and_si256(hi_sel,_mm256_set1_epi8(0x10))));
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(p),_mm256_sub_epi8(c,dec));
+    }
+#endif
+    for(;i<n;i+=8,p+=32){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        int  j=boost::core::countr_zero(w);
+        auto s=(j&1)*4;
+        auto& c=p[j>>1];
+        auto v=(c>>s)&0x0Fu;
+        if(v!=0x0Fu&&v!=0)c=(unsigned char)(c-(1u<<s));
+      }
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(
+    const unsigned char* p,const unsigned char* fp,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+8<=n;i+=8,p+=32){
+      boost::uint64_t m;
+      std::memcpy(&m,fp+i,8);
+      if(!m)continue;
+      __m256i lo_sel,hi_sel;
+      expand(m,lo_sel,hi_sel);
+      const __m256i zero=_mm256_setzero_si256();
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      __m256i z=_mm256_or_si256(
+        _mm256_and_si256(
+          _mm256_cmpeq_epi8(_mm256_and_si256(c,lo_nibbles()),zero),lo_sel),
+        _mm256_and_si256(
+          _mm256_cmpeq_epi8(_mm256_and_si256(c,hi_nibbles()),zero),hi_sel));
+      if(!_mm256_testz_si256(z,z))return false;
+    }
+#endif
+    for(;i<n;i+=8,p+=32){
+      for(auto w=load_word(fp+i,n-i);w;w&=w-1){
+        int j=boost::core::countr_zero(w);
+        if(!((p[j>>1]>>((j&1)*4))&0x0Fu))return false;
+      }
+    }
+    return true;
+  }
+
+  static void to_bits(const unsigned char* p,unsigned char* out,std::size_t n)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i+8<=n;i+=8,p+=32){
+      const __m256i zero=_mm256_setzero_si256();
+      __m256i c=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      boost::uint32_t even=~(boost::uint32_t)_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(
+                          _mm256_and_si256(c,lo_nibbles()),zero)),
+                      odd=~(boost::uint32_t)_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(
+                          _mm256_and_si256(c,hi_nibbles()),zero));
+      boost::uint64_t m=interleave_zeros(even)|(interleave_zeros(odd)<<1);
+      std::memcpy(out+i,&m,8);
+    }
+#endif
+    for(;i<n;++i,p+=4){
+      unsigned int b=0;
+      for(int j=0;j<4;++j){
+        b|=(unsigned int)((p[j]&0x0Fu)!=0)<<(2*j);
+        b|=(unsigned int)((p[j]&0xF0u)!=0)<<(2*j+1);
+      }
+      out[i]=(unsigned char)b;
+    }
+  }
+
+private:
+#if defined(BOOST_BLOOM_AVX2)
+  static BOOST_FORCEINLINE __m256i lo_nibbles()
+  {
+    return _mm256_set1_epi8(0x0F);
+  }
+
+  static BOOST_FORCEINLINE __m256i hi_nibbles()
+  {
+    return _mm256_set1_epi8((char)0xF0);
+  }
+
+  /* byte j of lo_sel (hi_sel) set to 0xFF iff bit 2*j (2*j+1) of m is set */
+
+  static BOOST_FORCEINLINE void expand(
+    boost::uint64_t m,__m256i& lo_sel,__m256i& hi_sel)
+  {
+    const __m256i shuffle=_mm256_setr_epi8(
+      0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,
+      4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7);
+    const __m256i lo_bits=_mm256_set1_epi32(0x40100401),
+                  hi_bits=_mm256_set1_epi32((int)0x80200802u);
+
+    __m256i v=_mm256_shuffle_epi8(_mm256_set1_epi64x((long long)m),shuffle);
+    lo_sel=_mm256_cmpeq_epi8(_mm256_and_si256(v,lo_bits),lo_bits);
+    hi_sel=_mm256_cmpeq_epi8(_mm256_and_si256(v,hi_bits),hi_bits);
+  }
+
+  /* bit j of x moved to bit 2*j */
+
+  static BOOST_FORCEINLINE boost::uint64_t interleave_zeros(boost::uint32_t x)
+  {
+    boost::uint64_t y=x;
+    y=(y|(y<<16))&0x0000FFFF0000FFFFull;
+    y=(y|(y<<8)) &0x00FF00FF00FF00FFull;
+    y=(y|(y<<4)) &0x0F0F0F0F0F0F0F0Full;
+    y=(y|(y<<2)) &0x3333333333333333ull;
+    y=(y|(y<<1)) &0x5555555555555555ull;
+    return y;
+  }
+#endif
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
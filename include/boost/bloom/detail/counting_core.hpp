@@ -0,0 +1,255 @@
+/* Common base for all boost::bloom::counting_filter instantiations.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COUNTING_CORE_HPP
+#define BOOST_BLOOM_DETAIL_COUNTING_CORE_HPP
+
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/counters.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* counting_core replaces each bit of the array of the corresponding
+ * filter_core with a saturating counter of CounterBits bits (see
+ * <boost/bloom/detail/counters.hpp>). Positions and hash values are
+ * obtained exactly as in filter_core, and the bits that subfilter::mark
+ * would set on the bucket are computed by marking a zeroed block: the
+ * counters of these bits are then incremented/decremented/checked. So,
+ * the bits of the counters that are non-zero form the array of a
+ * filter_core with the same elements inserted, as long as no element
+ * has been erased that wasn't previously inserted and no counter
+ * has saturated.
+ */
+
+template<
+  std::size_t K,typename Subfilter,std::size_t BucketSize,
+  std::size_t CounterBits,typename Allocator,typename HashStrategy
+>
+class counting_core
+{
+  static_assert(
+    CounterBits==4||CounterBits==8,"CounterBits must be 4 or 8");
+
+  using plain_core=filter_core<
+    K,Subfilter,BucketSize,Allocator,HashStrategy>;
+  using counter_ops=detail::counter_ops<CounterBits>;
+  using block_type=typename plain_core::block_type;
+  static constexpr std::size_t used_value_size=plain_core::used_value_size;
+  static constexpr std::size_t cacheline=64;
+  static constexpr std::size_t prefetched_cachelines=
+    1+(used_value_size*CounterBits+cacheline-1)/cacheline;
+
+public:
+  static constexpr std::size_t k=K;
+  using subfilter=Subfilter;
+  using hash_strategy=HashStrategy;
+  static constexpr std::size_t bucket_size=plain_core::bucket_size;
+  static constexpr std::size_t counter_bits=CounterBits;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+
+  explicit counting_core(std::size_t m=0):
+    counting_core{m,allocator_type{}}{}
+
+  counting_core(std::size_t m,const allocator_type& al):
+    hs{plain_core::requested_range(m)},
+    counters(
+      m?plain_core::used_array_size(hs.range())*CounterBits:0,
+      (unsigned char)0,al){}
+
+  counting_core(std::size_t n,double fpr,const allocator_type& al):
+    counting_core{plain_core::unadjusted_capacity_for(n,fpr),al}{}
+
+  counting_core(const counting_core&)=default;
+
+  counting_core(counting_core&& x)noexcept:
+    hs{x.hs},counters(std::move(x.counters))
+  {
+    x.hs=hash_strategy{0};
+    x.counters.clear();
+  }
+
+  counting_core& operator=(const counting_core&)=default;
+
+  counting_core& operator=(counting_core&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    if(this!=&x){
+      hs=x.hs;
+      counters=std::move(x.counters);
+      x.hs=hash_strategy{0};
+      x.counters.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return counters.get_allocator();
+  }
+
+  /* number of counters, i.e. capacity of the equivalent filter_core */
+
+  std::size_t capacity()const noexcept
+  {
+    return plain_core::used_array_size(range())*CHAR_BIT;
+  }
+
+  static std::size_t capacity_for(std::size_t n,double fpr)
+  {
+    return plain_core::capacity_for(n,fpr);
+  }
+
+  static double fpr_for(std::size_t n,std::size_t m)
+  {
+    return plain_core::fpr_for(n,m);
+  }
+
+  BOOST_FORCEINLINE void insert(boost::uint64_t hash)
+  {
+    if(BOOST_UNLIKELY(counters.empty()))return;
+    for_each_bucket(
+      counters.data(),hash,[](unsigned char* p,const unsigned char* fp){
+        counter_ops::increment(p,fp,used_value_size);
+        return true;
+      });
+  }
+
+  /* checks first so as to leave the counters untouched if the element is
+   * known not to be present
+   */
+
+  BOOST_FORCEINLINE bool erase(boost::uint64_t hash)
+  {
+    if(BOOST_UNLIKELY(counters.empty())||!may_contain(hash))return false;
+    for_each_bucket(
+      counters.data(),hash,[](unsigned char* p,const unsigned char* fp){
+        counter_ops::decrement(p,fp,used_value_size);
+        return true;
+      });
+    return true;
+  }
+
+  BOOST_FORCEINLINE bool may_contain(boost::uint64_t hash)const
+  {
+    if(BOOST_UNLIKELY(counters.empty()))return true;
+    return for_each_bucket(
+      counters.data(),hash,[](const unsigned char* p,const unsigned char* fp){
+        return counter_ops::check(p,fp,used_value_size);
+      });
+  }
+
+  void swap(counting_core& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    std::swap(hs,x.hs);
+    counters.swap(x.counters);
+  }
+
+  void clear()noexcept
+  {
+    if(!counters.empty())std::memset(counters.data(),0,counters.size());
+  }
+
+  /* writes the array of the equivalent filter_core into out */
+
+  void to_bits(unsigned char* out)const
+  {
+    if(counters.empty())return;
+    counter_ops::to_bits(
+      counters.data(),out,plain_core::used_array_size(range()));
+  }
+
+  friend bool operator==(const counting_core& x,const counting_core& y)
+  {
+    return x.range()==y.range()&&x.counters==y.counters;
+  }
+
+private:
+  std::size_t range()const noexcept
+  {
+    return counters.empty()?0:hs.range();
+  }
+
+  /* Calls f(p,fp) for each of the k buckets of the element, p pointing to
+   * the counters of the bucket (from base, the beginning of the counter
+   * array) and fp to the bits marked on it, stopping when f returns false.
+   * The next bucket is prefetched before f is called on the current one.
+   */
+
+  template<typename Pointer,typename F>
+  BOOST_FORCEINLINE bool for_each_bucket(
+    Pointer base,boost::uint64_t hash,F f)const
+  {
+    hs.prepare_hash(hash);
+    auto p=next_element(base,hash);
+    for(auto n=k;n--;){
+      auto p0=p;
+      auto hash0=hash;
+      if(n)p=next_element(base,hash);
+
+      block_type fp;
+      std::memset(&fp,0,sizeof(fp));
+      subfilter::mark(fp,hash0);
+      if(!f(p0,reinterpret_cast<const unsigned char*>(&fp)))return false;
+    }
+    return true;
+  }
+
+  BOOST_FORCEINLINE unsigned char* next_element(
+    unsigned char* base,boost::uint64_t& h)const noexcept
+  {
+    auto p=base+hs.next_position(h)*bucket_size*CounterBits;
+    for(std::size_t i=0;i<prefetched_cachelines;++i){
+      BOOST_BLOOM_PREFETCH_WRITE(p+i*cacheline);
+    }
+    return p;
+  }
+
+  BOOST_FORCEINLINE const unsigned char* next_element(
+    const unsigned char* base,boost::uint64_t& h)const noexcept
+  {
+    auto p=base+hs.next_position(h)*bucket_size*CounterBits;
+    for(std::size_t i=0;i<prefetched_cachelines;++i){
+      BOOST_BLOOM_PREFETCH(p+i*cacheline);
+    }
+    return p;
+  }
+
+  hash_strategy                             hs;
+  std::vector<unsigned char,allocator_type> counters;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
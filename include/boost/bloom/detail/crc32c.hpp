@@ -0,0 +1,246 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_CRC32C_HPP
+#define BOOST_BLOOM_DETAIL_CRC32C_HPP
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+/* CRC32C (Castagnoli) is computed with the crc32 instruction of SSE4.2 on
+ * x64 and of ARMv8 on AArch64. On x64, if SSE4.2 is not enabled at compile
+ * time, the instruction is used via function-level target attributes
+ * (GCC, Clang) or intrinsics (MSVC) after checking for it with cpuid.
+ * Elsewhere, a slicing-by-8 table-based implementation is used.
+ */
+
+#if (defined(__x86_64__)||defined(_M_X64))&& \
+    (defined(__SSE4_2__)|| \
+     (defined(BOOST_GCC)&&BOOST_GCC>=40900)||defined(BOOST_CLANG)|| \
+     defined(BOOST_MSVC))
+#define BOOST_BLOOM_CRC32C_X64
+#include <nmmintrin.h>
+#if !defined(__SSE4_2__)
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+#include <cpuid.h>
+#define BOOST_BLOOM_CRC32C_TARGET __attribute__((target("sse4.2")))
+#else
+#include <intrin.h>
+#endif
+#endif
+#elif defined(__aarch64__)&&defined(__ARM_FEATURE_CRC32)&& \
+      !defined(__AARCH64EB__)
+#define BOOST_BLOOM_CRC32C_ARM64
+#include <arm_acle.h>
+#endif
+
+#if !defined(BOOST_BLOOM_CRC32C_TARGET)
+#define BOOST_BLOOM_CRC32C_TARGET
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+static constexpr boost::uint32_t crc32c_poly=0x82F63B78u; /* reflected */
+
+/* a*b mod P for polynomials in reflected representation (bit 31 is the
+ * coefficient of x^0), a!=0
+ */
+
+inline boost::uint32_t crc32c_multmodp(boost::uint32_t a,boost::uint32_t b)
+{
+  boost::uint32_t m=1u<<31,p=0;
+  for(;;){
+    if(a&m){
+      p^=b;
+      if(!(a&(m-1)))break;
+    }
+    m>>=1;
+    b=b&1?(b>>1)^crc32c_poly:b>>1;
+  }
+  return p;
+}
+
+/* x^(8*n) mod P: multiplying the CRC register of some data by this value
+ * gives the register after appending n zero bytes to the data
+ */
+
+inline boost::uint32_t crc32c_x8nmodp(std::size_t n)
+{
+  boost::uint32_t p=1u<<31, /* x^0 */
+                  x=1u<<23; /* x^8 */
+  for(;n;n>>=1){
+    if(n&1)p=crc32c_multmodp(x,p);
+    x=crc32c_multmodp(x,x);
+  }
+  return p;
+}
+
+inline boost::uint32_t crc32c_load32(const unsigned char* p)
+{
+  return
+    (boost::uint32_t)p[0]|(boost::uint32_t)p[1]<<8|
+    (boost::uint32_t)p[2]<<16|(boost::uint32_t)p[3]<<24;
+}
+
+struct crc32c_tables
+{
+  crc32c_tables()
+  {
+    for(boost::uint32_t i=0;i<256;++i){
+      boost::uint32_t c=i;
+      for(int j=0;j<8;++j)c=c&1?(c>>1)^crc32c_poly:c>>1;
+      t[0][i]=c;
+    }
+    for(int k=1;k<8;++k){
+      for(int i=0;i<256;++i){
+        t[k][i]=(t[k-1][i]>>8)^t[0][t[k-1][i]&0xFF];
+      }
+    }
+  }
+
+  boost::uint32_t t[8][256];
+};
+
+inline const crc32c_tables& crc32c_table()
+{
+  static const crc32c_tables tables;
+  return tables;
+}
+
+/* functions below work on the raw CRC register (no pre/post inversion) */
+
+inline boost::uint32_t crc32c_sw(
+  boost::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+  const auto& t=crc32c_table().t;
+  for(;n>=8;n-=8,p+=8){
+    boost::uint32_t lo=crc32c_load32(p)^crc,hi=crc32c_load32(p+4);
+    crc=
+      t[7][lo&0xFF]^t[6][(lo>>8)&0xFF]^t[5][(lo>>16)&0xFF]^t[4][lo>>24]^
+      t[3][hi&0xFF]^t[2][(hi>>8)&0xFF]^t[1][(hi>>16)&0xFF]^t[0][hi>>24];
+  }
+  for(;n;--n)crc=t[0][(crc^*p++)&0xFF]^(crc>>8);
+  return crc;
+}
+
+#if defined(BOOST_BLOOM_CRC32C_X64)||defined(BOOST_BLOOM_CRC32C_ARM64)
+#define BOOST_BLOOM_CRC32C_HW
+
+#if defined(BOOST_BLOOM_CRC32C_X64)
+BOOST_FORCEINLINE BOOST_BLOOM_CRC32C_TARGET
+boost::uint32_t crc32c_u64(boost::uint32_t crc,const unsigned char* p)
+{
+  boost::uint64_t x;
+  std::memcpy(&x,p,sizeof(x));
+  return (boost::uint32_t)_mm_crc32_u64(crc,x);
+}
+
+BOOST_FORCEINLINE BOOST_BLOOM_CRC32C_TARGET
+boost::uint32_t crc32c_u8(boost::uint32_t crc,unsigned char x)
+{
+  return _mm_crc32_u8(crc,x);
+}
+#else
+BOOST_FORCEINLINE
+boost::uint32_t crc32c_u64(boost::uint32_t crc,const unsigned char* p)
+{
+  boost::uint64_t x;
+  std::memcpy(&x,p,sizeof(x));
+  return __crc32cd(crc,x);
+}
+
+BOOST_FORCEINLINE
+boost::uint32_t crc32c_u8(boost::uint32_t crc,unsigned char x)
+{
+  return __crc32cb(crc,x);
+}
+#endif
+
+/* The crc32 instruction has a latency of 3 cycles and a throughput of 1
+ * per cycle, so large inputs are processed as three interleaved streams
+ * of crc32c_stride bytes each, whose CRCs are then combined.
+ */
+
+static constexpr std::size_t crc32c_stride=16384;
+
+inline BOOST_BLOOM_CRC32C_TARGET boost::uint32_t crc32c_hw(
+  boost::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+  static const boost::uint32_t x8n1=crc32c_x8nmodp(crc32c_stride),
+                               x8n2=crc32c_x8nmodp(2*crc32c_stride);
+
+  for(;n>=3*crc32c_stride;n-=3*crc32c_stride,p+=3*crc32c_stride){
+    boost::uint32_t crc1=0,crc2=0;
+    for(std::size_t i=0;i<crc32c_stride;i+=8){
+      crc=crc32c_u64(crc,p+i);
+      crc1=crc32c_u64(crc1,p+crc32c_stride+i);
+      crc2=crc32c_u64(crc2,p+2*crc32c_stride+i);
+    }
+    crc=crc32c_multmodp(x8n2,crc)^crc32c_multmodp(x8n1,crc1)^crc2;
+  }
+  for(;n>=8;n-=8,p+=8)crc=crc32c_u64(crc,p);
+  for(;n;--n)crc=crc32c_u8(crc,*p++);
+  return crc;
+}
+
+#if defined(BOOST_BLOOM_CRC32C_X64)&&!defined(__SSE4_2__)
+inline bool detect_crc32c_hw()
+{
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+  unsigned int regs[4];
+  if(!__get_cpuid(1,&regs[0],&regs[1],&regs[2],&regs[3]))return false;
+#else
+  int regs[4];
+  __cpuid(regs,1);
+#endif
+  return regs[2]&(1u<<20); /* SSE4.2 */
+}
+
+/* cpuid is executed once at dynamic initialization time; before that,
+ * the table-based implementation is used, which gives the same results.
+ */
+
+template<typename=void>
+struct crc32c_hw_holder
+{
+  static const bool value;
+};
+
+template<typename Dummy>
+const bool crc32c_hw_holder<Dummy>::value=detect_crc32c_hw();
+
+inline bool crc32c_hw_available()noexcept
+{
+  return crc32c_hw_holder<>::value;
+}
+#else
+inline bool crc32c_hw_available()noexcept{return true;}
+#endif
+
+#endif /* BOOST_BLOOM_CRC32C_X64||BOOST_BLOOM_CRC32C_ARM64 */
+
+/* CRC32C of [p,p+n) following on from that of preceding data, crc */
+
+inline boost::uint32_t crc32c(
+  const unsigned char* p,std::size_t n,boost::uint32_t crc=0)
+{
+  crc=~crc;
+#if defined(BOOST_BLOOM_CRC32C_HW)
+  if(crc32c_hw_available())return ~crc32c_hw(crc,p,n);
+#endif
+  return ~crc32c_sw(crc,p,n);
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
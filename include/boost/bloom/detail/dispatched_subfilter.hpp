@@ -0,0 +1,204 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_DISPATCHED_SUBFILTER_HPP
+#define BOOST_BLOOM_DETAIL_DISPATCHED_SUBFILTER_HPP
+
+#include <boost/bloom/detail/batch_check.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Subfilter forwarding to Generic, AVX2 or AVX512 depending on the
+ * capabilities of the host CPU. The three must have value_types of the
+ * same size and produce the same results; Generic::value_type must be
+ * aligned as required by the SIMD kernels. mark and check dispatch element by
+ * element; bulk lookup (through batch_check) selects a function pointer
+ * once and then checks batch_width elements per call.
+ */
+
+struct dispatched_subfilter_base{};
+
+template<typename Generic,typename AVX2,typename AVX512>
+struct dispatched_subfilter:Generic,dispatched_subfilter_base
+{
+  using value_type=typename Generic::value_type;
+  static constexpr std::size_t used_value_size=Generic::used_value_size;
+  static constexpr std::size_t batch_width=8;
+
+  static_assert(
+    sizeof(value_type)==sizeof(typename AVX2::value_type)&&
+    sizeof(value_type)==sizeof(typename AVX512::value_type),
+    "all kernels must have value_types of the same size");
+
+  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  {
+    switch(runtime_simd_level()){
+      case simd_level::avx512: mark_avx512(x,hash);break;
+      case simd_level::avx2:   mark_avx2(x,hash);break;
+      default:                 mark_generic(x,hash);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  {
+    switch(runtime_simd_level()){
+      case simd_level::avx512: return check_avx512(x,hash);
+      case simd_level::avx2:   return check_avx2(x,hash);
+      default:                 return check_generic(x,hash);
+    }
+  }
+
+  /* i-th bit of the result is check(x,hashes[i]), x being located at
+   * base+offsets[i], for i<batch_width.
+   */
+
+  static BOOST_FORCEINLINE int check_batch(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    static const check_batch_function f=select_check_batch();
+    return f(base,offsets,hashes);
+  }
+
+  static BOOST_FORCEINLINE void mark_generic(
+    value_type& x,boost::uint64_t hash)
+  {
+    Generic::mark(x,hash);
+  }
+
+  static BOOST_FORCEINLINE bool check_generic(
+    const value_type& x,boost::uint64_t hash)
+  {
+    return Generic::check(x,hash);
+  }
+
+  static BOOST_BLOOM_AVX2_TARGET void mark_avx2(
+    value_type& x,boost::uint64_t hash)
+  {
+    AVX2::mark(reinterpret_cast<typename AVX2::value_type&>(x),hash);
+  }
+
+  static BOOST_BLOOM_AVX2_TARGET bool check_avx2(
+    const value_type& x,boost::uint64_t hash)
+  {
+    return AVX2::check(
+      reinterpret_cast<const typename AVX2::value_type&>(x),hash);
+  }
+
+  static BOOST_BLOOM_AVX512_TARGET void mark_avx512(
+    value_type& x,boost::uint64_t hash)
+  {
+    AVX512::mark(reinterpret_cast<typename AVX512::value_type&>(x),hash);
+  }
+
+  static BOOST_BLOOM_AVX512_TARGET bool check_avx512(
+    const value_type& x,boost::uint64_t hash)
+  {
+    return AVX512::check(
+      reinterpret_cast<const typename AVX512::value_type&>(x),hash);
+  }
+
+private:
+  using check_batch_function=int(*)(
+    const unsigned char*,const boost::uint64_t*,const boost::uint64_t*);
+
+  static check_batch_function select_check_batch()
+  {
+    switch(runtime_simd_level()){
+      case simd_level::avx512: return &check_batch_avx512;
+      case simd_level::avx2:   return &check_batch_avx2;
+      default:                 return &check_batch_generic;
+    }
+  }
+
+  /* Values need not be properly aligned, in which case they are copied
+   * (copying aligned values too would incur store forwarding stalls). The
+   * loop body is repeated in each function so that the kernel is inlined
+   * into code compiled for its target.
+   */
+
+  static BOOST_FORCEINLINE const value_type& load(
+    const unsigned char* p,value_type& buf)
+  {
+    if(boost::uintptr_t(p)%alignof(value_type)==0){
+      return *reinterpret_cast<const value_type*>(p);
+    }
+    std::memcpy(&buf,p,used_value_size);
+    return buf;
+  }
+
+  static int check_batch_generic(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    int res=0;
+    for(std::size_t i=0;i<batch_width;++i){
+      value_type buf;
+      res|=(int)check_generic(load(base+offsets[i],buf),hashes[i])<<i;
+    }
+    return res;
+  }
+
+  static BOOST_BLOOM_AVX2_TARGET int check_batch_avx2(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    int res=0;
+    for(std::size_t i=0;i<batch_width;++i){
+      value_type buf;
+      res|=(int)check_avx2(load(base+offsets[i],buf),hashes[i])<<i;
+    }
+    return res;
+  }
+
+  static BOOST_BLOOM_AVX512_TARGET int check_batch_avx512(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    int res=0;
+    for(std::size_t i=0;i<batch_width;++i){
+      value_type buf;
+      res|=(int)check_avx512(load(base+offsets[i],buf),hashes[i])<<i;
+    }
+    return res;
+  }
+};
+
+template<typename Subfilter>
+struct batch_check<
+  Subfilter,
+  typename std::enable_if<
+    std::is_base_of<dispatched_subfilter_base,Subfilter>::value>::type
+>
+{
+  static constexpr std::size_t width=Subfilter::batch_width;
+
+  static BOOST_FORCEINLINE int check(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    return Subfilter::check_batch(base,offsets,hashes);
+  }
+};
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
+#endif
@@ -12,6 +12,7 @@
 #include <boost/bloom/detail/avx2.hpp>
 #include <boost/bloom/detail/multiblock_fpr_base.hpp>
 #include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
 #include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 #include <cstddef>
@@ -24,29 +25,33 @@ namespace bloom{
 #pragma warning(disable:4714) /* marked as __forceinline not inlined */
 #endif
 
+namespace detail{
+
 template<std::size_t K>
-struct fast_multiblock32:detail::multiblock_fpr_base<K>
+struct fast_multiblock32_avx2:multiblock_fpr_base<K>
 {
   static constexpr std::size_t k=K;
   using value_type=__m256i[(k+7)/8];
   static constexpr std::size_t used_value_size=sizeof(boost::uint32_t)*k;
 
-  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET void mark(
+    value_type& x,boost::uint64_t hash)
   {
     for(std::size_t i=0;i<k/8;++i){
       mark_m256i(x[i],hash,8);
-      hash=detail::mulx64(hash);
+      hash=mulx64(hash);
     }
     if(k%8){
       mark_m256i(x[k/8],hash,k%8);
     }
   }
 
-  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET bool check(
+    const value_type& x,boost::uint64_t hash)
   {
     for(std::size_t i=0;i<k/8;++i){
       if(!check_m256i(x[i],hash,8))return false;
-      hash=detail::mulx64(hash);
+      hash=mulx64(hash);
     }
     if(k%8){
       if(!check_m256i(x[k/8],hash,k%8))return false;
@@ -55,7 +60,7 @@ struct fast_multiblock32:detail::multiblock_fpr_base<K>
   }
 
 private:
-  static BOOST_FORCEINLINE __m256i make_m256i(
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET __m256i make_m256i(
     boost::uint64_t hash,std::size_t kp)
   {
     const __m256i ones[8]={
@@ -75,14 +80,14 @@ private:
     return _mm256_sllv_epi32(ones[kp-1],h);
   }
 
-  static BOOST_FORCEINLINE void mark_m256i(
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET void mark_m256i(
     __m256i& x,boost::uint64_t hash,std::size_t kp)
   {
     __m256i h=make_m256i(hash,kp);
     x=_mm256_or_si256(x,h);
   }
 
-  static BOOST_FORCEINLINE bool check_m256i(
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET bool check_m256i(
     const __m256i& x,boost::uint64_t hash,std::size_t kp)
   {
     __m256i h=make_m256i(hash,kp);
@@ -90,6 +95,8 @@ private:
   }
 };
 
+} /* namespace detail */
+
 #if defined(BOOST_MSVC)
 #pragma warning(pop) /* C4714 */
 #endif
@@ -0,0 +1,163 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK32_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK32_AVX512_HPP
+
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+namespace detail{
+
+/* Same layout and bit selection as the AVX2 implementation, so both produce
+ * the same arrays: the i-th __m256i is marked with the hash value mixed i
+ * times. Two such __m256is are processed in one __m512i.
+ */
+
+template<std::size_t K>
+struct fast_multiblock32_avx512:multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=__m256i[(k+7)/8];
+  static constexpr std::size_t used_value_size=sizeof(boost::uint32_t)*k;
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET void mark(
+    value_type& x,boost::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i){
+      boost::uint64_t hash2=mulx64(hash);
+      mark_m512i(&x[2*i],hash,hash2,16);
+      hash=mulx64(hash2);
+    }
+    if(k%16>8){
+      mark_m512i(&x[k/16*2],hash,mulx64(hash),k%16);
+    }
+    else if(k%16){
+      mark_m256i(x[k/16*2],hash,k%16);
+    }
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET bool check(
+    const value_type& x,boost::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i){
+      boost::uint64_t hash2=mulx64(hash);
+      if(!check_m512i(&x[2*i],hash,hash2,16))return false;
+      hash=mulx64(hash2);
+    }
+    if(k%16>8){
+      if(!check_m512i(&x[k/16*2],hash,mulx64(hash),k%16))return false;
+    }
+    else if(k%16){
+      if(!check_m256i(x[k/16*2],hash,k%16))return false;
+    }
+    return true;
+  }
+
+private:
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET __mmask16 make_mask(
+    std::size_t kp)
+  {
+    return (__mmask16)((1u<<kp)-1);
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET __m512i make_m512i(
+    boost::uint64_t hash,boost::uint64_t hash2,std::size_t kp)
+  {
+    /* 32-bit lanes alternately hold the low and high halves of hash (lanes
+     * 0-7) and hash2 (lanes 8-15).
+     */
+
+    __m512i h=_mm512_set_epi64(
+      (long long)hash2,(long long)hash2,(long long)hash2,(long long)hash2,
+      (long long)hash,(long long)hash,(long long)hash,(long long)hash);
+    h=_mm512_maskz_srlv_epi32(
+      make_mask(kp),h,
+      _mm512_set_epi32(
+        12,12,17,17,22,22,27,27,12,12,17,17,22,22,27,27));
+    h=_mm512_and_si512(h,_mm512_set1_epi32(31));
+    return _mm512_maskz_sllv_epi32(make_mask(kp),_mm512_set1_epi32(1),h);
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET void mark_m512i(
+    __m256i* p,boost::uint64_t hash,boost::uint64_t hash2,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,hash2,kp);
+    __m512i x=_mm512_maskz_loadu_epi32(make_mask(kp),p);
+    _mm512_mask_storeu_epi32(p,make_mask(kp),_mm512_or_si512(x,h));
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET bool check_m512i(
+    const __m256i* p,boost::uint64_t hash,boost::uint64_t hash2,
+    std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,hash2,kp);
+    __m512i x=_mm512_maskz_loadu_epi32(make_mask(kp),p);
+    return _mm512_cmpneq_epi32_mask(_mm512_and_si512(x,h),h)==0;
+  }
+
+  /* a trailing group of up to 8 words is processed as in AVX2 */
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET __m256i make_m256i(
+    boost::uint64_t hash,std::size_t kp)
+  {
+    const __m256i ones[8]={
+      _mm256_set_epi32(0,0,0,0,0,0,0,1),
+      _mm256_set_epi32(0,0,0,0,0,0,1,1),
+      _mm256_set_epi32(0,0,0,0,0,1,1,1),
+      _mm256_set_epi32(0,0,0,0,1,1,1,1),
+      _mm256_set_epi32(0,0,0,1,1,1,1,1),
+      _mm256_set_epi32(0,0,1,1,1,1,1,1),
+      _mm256_set_epi32(0,1,1,1,1,1,1,1),
+      _mm256_set_epi32(1,1,1,1,1,1,1,1),
+    };
+
+    __m256i h=_mm256_set1_epi64x(hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(15,10,5,0));
+    h=_mm256_srli_epi32(h,32-5);
+    return _mm256_sllv_epi32(ones[kp-1],h);
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET void mark_m256i(
+    __m256i& x,boost::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    x=_mm256_or_si256(x,h);
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET bool check_m256i(
+    const __m256i& x,boost::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    return _mm256_testc_si256(x,h);
+  }
+};
+
+} /* namespace detail */
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
@@ -12,6 +12,7 @@
 #include <boost/bloom/detail/avx2.hpp>
 #include <boost/bloom/detail/multiblock_fpr_base.hpp>
 #include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
 #include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 #include <cstddef>
@@ -31,31 +32,31 @@ struct m256ix2
   __m256i lo,hi;
 };
 
-} /* namespace detail */
-
 template<std::size_t K>
-struct fast_multiblock64:detail::multiblock_fpr_base<K>
+struct fast_multiblock64_avx2:multiblock_fpr_base<K>
 {
   static constexpr std::size_t k=K;
-  using value_type=detail::m256ix2[(k+7)/8];
+  using value_type=m256ix2[(k+7)/8];
   static constexpr std::size_t used_value_size=sizeof(boost::uint64_t)*k;
 
-  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET void mark(
+    value_type& x,boost::uint64_t hash)
   {
-    for(int i=0;i<k/8;++i){
+    for(std::size_t i=0;i<k/8;++i){
       mark_m256ix2(x[i],hash,8);
-      hash=detail::mulx64(hash);
+      hash=mulx64(hash);
     }
     if(k%8){
       mark_m256ix2(x[k/8],hash,k%8);
     }
   }
 
-  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET bool check(
+    const value_type& x,boost::uint64_t hash)
   {
-    for(int i=0;i<k/8;++i){
+    for(std::size_t i=0;i<k/8;++i){
       if(!check_m256ix2(x[i],hash,8))return false;
-      hash=detail::mulx64(hash);
+      hash=mulx64(hash);
     }
     if(k%8){
       if(!check_m256ix2(x[k/8],hash,k%8))return false;
@@ -64,10 +65,10 @@ struct fast_multiblock64:detail::multiblock_fpr_base<K>
   }
 
 private:
-  static BOOST_FORCEINLINE detail::m256ix2 make_m256ix2(
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET m256ix2 make_m256ix2(
     boost::uint64_t hash,std::size_t kp)
   {
-    const detail::m256ix2 ones[8]={
+    const m256ix2 ones[8]={
       {_mm256_set_epi64x(0,0,0,1),_mm256_set_epi64x(0,0,0,0)},
       {_mm256_set_epi64x(0,0,1,1),_mm256_set_epi64x(0,0,0,0)},
       {_mm256_set_epi64x(0,1,1,1),_mm256_set_epi64x(0,0,0,0)},
@@ -91,24 +92,26 @@ private:
     };
   }
 
-  static BOOST_FORCEINLINE void mark_m256ix2(
-    detail::m256ix2& x,boost::uint64_t hash,std::size_t kp)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET void mark_m256ix2(
+    m256ix2& x,boost::uint64_t hash,std::size_t kp)
   {
-    detail::m256ix2 h=make_m256ix2(hash,kp);
+    m256ix2 h=make_m256ix2(hash,kp);
     x.lo=_mm256_or_si256(x.lo,h.lo);
     if(kp>4)x.hi=_mm256_or_si256(x.hi,h.hi);
   }
 
-  static BOOST_FORCEINLINE bool check_m256ix2(
-    const detail::m256ix2& x,boost::uint64_t hash,std::size_t kp)
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX2_TARGET bool check_m256ix2(
+    const m256ix2& x,boost::uint64_t hash,std::size_t kp)
   {
-    detail::m256ix2 h=make_m256ix2(hash,kp);
+    m256ix2 h=make_m256ix2(hash,kp);
     auto res=_mm256_testc_si256(x.lo,h.lo);
     if(kp>4)res&=_mm256_testc_si256(x.hi,h.hi);
     return res;
   }
 };
 
+} /* namespace detail */
+
 #if defined(BOOST_MSVC)
 #pragma warning(pop) /* C4714 */
 #endif
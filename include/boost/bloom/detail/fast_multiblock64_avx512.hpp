@@ -0,0 +1,111 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_AVX512_HPP
+
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/fast_multiblock64_avx2.hpp>
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+namespace detail{
+
+/* Same layout and bit selection as the AVX2 implementation, so both produce
+ * the same arrays; each m256ix2 is processed in one __m512i.
+ */
+
+template<std::size_t K>
+struct fast_multiblock64_avx512:multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=m256ix2[(k+7)/8];
+  static constexpr std::size_t used_value_size=sizeof(boost::uint64_t)*k;
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET void mark(
+    value_type& x,boost::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_m512i(x[i],hash,8);
+      hash=mulx64(hash);
+    }
+    if(k%8){
+      mark_m512i(x[k/8],hash,k%8);
+    }
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET bool check(
+    const value_type& x,boost::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_m512i(x[i],hash,8))return false;
+      hash=mulx64(hash);
+    }
+    if(k%8){
+      if(!check_m512i(x[k/8],hash,k%8))return false;
+    }
+    return true;
+  }
+
+private:
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET __mmask8 make_mask(
+    std::size_t kp)
+  {
+    return (__mmask8)((1u<<kp)-1);
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET __m512i make_m512i(
+    boost::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(18,12,6,0));
+    h=_mm256_srli_epi32(h,32-6);
+    return _mm512_maskz_sllv_epi64(
+      make_mask(kp),_mm512_set1_epi64(1),
+      _mm512_maskz_cvtepu32_epi64(make_mask(kp),h));
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET void mark_m512i(
+    m256ix2& x,boost::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i v=_mm512_maskz_loadu_epi64(make_mask(kp),&x);
+    _mm512_mask_storeu_epi64(&x,make_mask(kp),_mm512_or_si512(v,h));
+  }
+
+  static BOOST_FORCEINLINE BOOST_BLOOM_AVX512_TARGET bool check_m512i(
+    const m256ix2& x,boost::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i v=_mm512_maskz_loadu_epi64(make_mask(kp),&x);
+    return _mm512_cmpneq_epi64_mask(_mm512_and_si512(v,h),h)==0;
+  }
+};
+
+} /* namespace detail */
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
@@ -0,0 +1,91 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK_GENERIC_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK_GENERIC_HPP
+
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Non-SIMD implementation of the bit selection of the AVX2 variants of
+ * fast_multiblock32 (Block=uint32_t) and fast_multiblock64 (Block=uint64_t)
+ * over the value_type of the AVX2 implementation Layout, so that arrays
+ * are interchangeable: in each group of 8 words, word 2*q (resp. 2*q+1)
+ * selects its bit from the low (resp. high) 32-bit half of the hash value,
+ * skipping the bit portions used by the previous words; the hash value is
+ * mixed after each group.
+ *
+ * value_type is raw storage with the size and alignment of the AVX2
+ * value_type: when AVX is not enabled, GCC gives __m256i an alignment of
+ * only 16, which would be wrong for the SIMD kernels.
+ */
+
+template<std::size_t Size>
+struct alignas(32) simd_storage
+{
+  unsigned char data[Size];
+};
+
+template<typename Block,std::size_t K,typename Layout>
+struct fast_multiblock_generic:multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=simd_storage<sizeof(typename Layout::value_type)>;
+  static constexpr std::size_t used_value_size=sizeof(Block)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  {
+    auto p=reinterpret_cast<unsigned char*>(&x);
+    loop(hash,[&](std::size_t i,Block m){
+      Block w;
+      std::memcpy(&w,p+i*sizeof(Block),sizeof(Block));
+      w|=m;
+      std::memcpy(p+i*sizeof(Block),&w,sizeof(Block));
+      return true;
+    });
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  {
+    auto p=reinterpret_cast<const unsigned char*>(&x);
+    return loop(hash,[&](std::size_t i,Block m){
+      Block w;
+      std::memcpy(&w,p+i*sizeof(Block),sizeof(Block));
+      return (w&m)!=0;
+    });
+  }
+
+private:
+  static constexpr int bits=sizeof(Block)==4?5:6;
+
+  template<typename F>
+  static BOOST_FORCEINLINE bool loop(boost::uint64_t hash,F f)
+  {
+    for(std::size_t i=0;i<k;++i){
+      if(i&&i%8==0)hash=mulx64(hash);
+      int q=(int)(i%8)/2,
+          shift=(i%2?64:32)-bits*(q+1);
+      if(!f(i,Block(1)<<((hash>>shift)&((1u<<bits)-1))))return false;
+    }
+    return true;
+  }
+};
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
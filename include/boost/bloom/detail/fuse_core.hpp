@@ -0,0 +1,507 @@
+/* Common base for all boost::bloom::static_filter instantiations.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FUSE_CORE_HPP
+#define BOOST_BLOOM_DETAIL_FUSE_CORE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/detail/core.hpp> /* BOOST_BLOOM_PREFETCH */
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Binary fuse filter with 3-wise hashing, as described in
+ * Graf and Lemire, "Binary Fuse Filters: Fast and Smaller Than Xor
+ * Filters", ACM JEA 27, 2022. The array of fingerprints is divided into
+ * segments, and each element is mapped to one position in each of three
+ * consecutive segments (starting at the segment pointed to by the high
+ * bits of the hash) so that the fingerprint of the element is the XOR of
+ * the values at those positions.
+ *
+ * Construction works on the 64-bit hash values of the elements. These are
+ * remixed with a seed through a bijective function, so that distinct hash
+ * values stay distinct, and the resulting hypergraph is peeled; if this
+ * fails, the hash values are deduplicated and a new seed is tried.
+ */
+
+struct sequential_executor
+{
+  template<typename F>
+  void operator()(std::size_t n,F f)const
+  {
+    for(std::size_t i=0;i<n;++i)f(i);
+  }
+};
+
+template<std::size_t FingerprintBits,typename Allocator>
+class fuse_core
+{
+  static_assert(
+    FingerprintBits==8||FingerprintBits==16,
+    "FingerprintBits must be 8 or 16");
+
+public:
+  using fingerprint_type=typename std::conditional<
+    FingerprintBits==8,boost::uint8_t,boost::uint16_t
+  >::type;
+  static constexpr std::size_t fingerprint_bits=FingerprintBits;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+
+  /* maximum number of elements processed in one go by bulk operations */
+  static constexpr std::size_t bulk_lookup_size=16;
+
+  explicit fuse_core(const allocator_type& al=allocator_type{}):
+    fingerprints(fingerprint_allocator{al}){}
+
+  fuse_core(const fuse_core&)=default;
+
+  fuse_core(fuse_core&& x)noexcept:
+    seed{x.seed},segment_length{x.segment_length},
+    segment_length_mask{x.segment_length_mask},
+    segment_count_length{x.segment_count_length},
+    fingerprints(std::move(x.fingerprints))
+  {
+    x.reset_parameters();
+    x.fingerprints.clear();
+  }
+
+  fuse_core& operator=(const fuse_core&)=default;
+
+  fuse_core& operator=(fuse_core&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<
+      fingerprint_allocator>::value||
+    allocator_is_always_equal_t<fingerprint_allocator>::value)
+  {
+    if(this!=&x){
+      seed=x.seed;
+      segment_length=x.segment_length;
+      segment_length_mask=x.segment_length_mask;
+      segment_count_length=x.segment_count_length;
+      fingerprints=std::move(x.fingerprints);
+      x.reset_parameters();
+      x.fingerprints.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return allocator_type(fingerprints.get_allocator());
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return fingerprints.size()*FingerprintBits;
+  }
+
+  static double fpr()noexcept
+  {
+    return 1.0/(double)(boost::uint64_t(1)<<FingerprintBits);
+  }
+
+  BOOST_FORCEINLINE bool may_contain(boost::uint64_t hash)const
+  {
+    if(BOOST_UNLIKELY(fingerprints.empty()))return false;
+    hash=remix(hash,seed);
+    std::size_t pos[3];
+    positions(hash,pos);
+    auto p=fingerprints.data();
+    return (fingerprint_type)(fingerprint(hash)^p[pos[0]]^p[pos[1]]^p[pos[2]])
+      ==0;
+  }
+
+  /* positions of all the elements are calculated and prefetched before
+   * any is checked, so that memory accesses overlap
+   */
+
+  void bulk_may_contain(boost::uint64_t* hashes,std::size_t n,bool* res)const
+  {
+    BOOST_ASSERT(n<=bulk_lookup_size);
+
+    if(BOOST_UNLIKELY(fingerprints.empty())){
+      std::fill(res,res+n,false);
+      return;
+    }
+
+    auto        p=fingerprints.data();
+    std::size_t pos[bulk_lookup_size][3];
+    for(std::size_t i=0;i<n;++i){
+      hashes[i]=remix(hashes[i],seed);
+      positions(hashes[i],pos[i]);
+      BOOST_BLOOM_PREFETCH(p+pos[i][0]);
+      BOOST_BLOOM_PREFETCH(p+pos[i][1]);
+      BOOST_BLOOM_PREFETCH(p+pos[i][2]);
+    }
+    for(std::size_t i=0;i<n;++i){
+      res[i]=(fingerprint_type)(
+        fingerprint(hashes[i])^p[pos[i][0]]^p[pos[i][1]]^p[pos[i][2]])==0;
+    }
+  }
+
+  /* Builds the filter for the n hash values returned by hash_at(i),
+   * i in [0,n). Hashing and the locality sort of the hash values preceding
+   * each construction attempt are split into chunks run through ex;
+   * peeling and fingerprint assignment are inherently sequential.
+   */
+
+  template<typename HashAt,typename Executor>
+  void build(std::size_t n,HashAt hash_at,Executor& ex)
+  {
+    hash_buffer hashes(n,boost::uint64_t(0),hash_allocator{get_allocator()});
+    std::size_t num_chunks=num_chunks_for(n),
+                chunk_size=num_chunks?(n+num_chunks-1)/num_chunks:0;
+    ex(num_chunks,[&](std::size_t j){
+      for(std::size_t i=j*chunk_size,
+          last=(std::min)(i+chunk_size,n);i<last;++i){
+        hashes[i]=hash_at(i);
+      }
+    });
+    build_from_hashes(hashes,ex);
+  }
+
+  /* same as above for hash values provided sequentially by gen(hash) */
+
+  template<typename HashGenerator>
+  void build_sequential(HashGenerator gen)
+  {
+    hash_buffer     hashes(hash_allocator{get_allocator()});
+    boost::uint64_t hash;
+    while(gen(hash))hashes.push_back(hash);
+    sequential_executor ex;
+    build_from_hashes(hashes,ex);
+  }
+
+  void swap(fuse_core& x)noexcept(
+    allocator_propagate_on_container_swap_t<fingerprint_allocator>::value||
+    allocator_is_always_equal_t<fingerprint_allocator>::value)
+  {
+    std::swap(seed,x.seed);
+    std::swap(segment_length,x.segment_length);
+    std::swap(segment_length_mask,x.segment_length_mask);
+    std::swap(segment_count_length,x.segment_count_length);
+    fingerprints.swap(x.fingerprints);
+  }
+
+  friend bool operator==(const fuse_core& x,const fuse_core& y)
+  {
+    return
+      x.seed==y.seed&&
+      x.segment_length==y.segment_length&&
+      x.segment_count_length==y.segment_count_length&&
+      x.fingerprints==y.fingerprints;
+  }
+
+private:
+  using fingerprint_allocator=
+    allocator_rebind_t<allocator_type,fingerprint_type>;
+  using hash_allocator=allocator_rebind_t<allocator_type,boost::uint64_t>;
+  using hash_buffer=std::vector<boost::uint64_t,hash_allocator>;
+  using count_allocator=allocator_rebind_t<allocator_type,unsigned char>;
+  using index_allocator=allocator_rebind_t<allocator_type,std::size_t>;
+
+  static constexpr std::size_t max_segment_length=std::size_t(1)<<18;
+  static constexpr int         max_region_bits=10;
+  static constexpr std::size_t max_num_chunks=256;
+  static constexpr std::size_t min_chunk_size=std::size_t(1)<<14;
+  static constexpr int         max_attempts=1000;
+
+  /* bijective for a given seed (murmur3's fmix64 finalizer) */
+
+  static BOOST_FORCEINLINE boost::uint64_t remix(
+    boost::uint64_t hash,boost::uint64_t seed)
+  {
+    hash+=seed;
+    hash^=hash>>33;
+    hash*=0xff51afd7ed558ccdull;
+    hash^=hash>>33;
+    hash*=0xc4ceb9fe1a85ec53ull;
+    hash^=hash>>33;
+    return hash;
+  }
+
+  static BOOST_FORCEINLINE fingerprint_type fingerprint(boost::uint64_t hash)
+  {
+    return (fingerprint_type)(hash^(hash>>32));
+  }
+
+  BOOST_FORCEINLINE void positions(
+    boost::uint64_t hash,std::size_t* pos)const
+  {
+    boost::uint64_t hi;
+    umul128(hash,segment_count_length,hi);
+    pos[0]=(std::size_t)hi;
+    pos[1]=pos[0]+segment_length;
+    pos[2]=pos[1]+segment_length;
+    pos[1]^=(std::size_t)(hash>>18)&segment_length_mask;
+    pos[2]^=(std::size_t)hash&segment_length_mask;
+  }
+
+  static std::size_t num_chunks_for(std::size_t n)
+  {
+    return (std::min)(
+      (n+min_chunk_size-1)/min_chunk_size,(std::size_t)max_num_chunks);
+  }
+
+  void reset_parameters()noexcept
+  {
+    seed=0;
+    segment_length=0;
+    segment_length_mask=0;
+    segment_count_length=0;
+  }
+
+  /* sizing as in the reference implementation for arity 3 */
+
+  void set_parameters(std::size_t n)
+  {
+    static constexpr long long arity=3;
+
+    segment_length=n==0?4:(std::min)(
+      std::size_t(1)<<
+        (int)std::floor(std::log((double)n)/std::log(3.33)+2.25),
+      (std::size_t)max_segment_length);
+    segment_length_mask=segment_length-1;
+
+    double size_factor=n<=1?0.0:(std::max)(
+      1.125,0.875+0.25*std::log(1000000.0)/std::log((double)n));
+    long long sl=(long long)segment_length,
+              cap=(long long)std::round((double)n*size_factor),
+              init_segment_count=(cap+sl-1)/sl-(arity-1),
+              array_length=(init_segment_count+arity-1)*sl,
+              segment_count=(array_length+sl-1)/sl;
+    segment_count=segment_count<=arity-1?1:segment_count-(arity-1);
+    segment_count_length=(boost::uint64_t)(segment_count*sl);
+    fingerprints.assign(
+      (std::size_t)((segment_count+arity-1)*sl),fingerprint_type(0));
+  }
+
+  template<typename Executor>
+  void build_from_hashes(hash_buffer& hashes,Executor& ex)
+  {
+    std::size_t n=hashes.size();
+    if(n==0){
+      reset_parameters();
+      fingerprints.clear();
+      return;
+    }
+    set_parameters(n);
+
+    std::size_t array_length=fingerprints.size(),
+                segment_count=
+                  (std::size_t)(segment_count_length/segment_length);
+    int         region_bits=0;
+    while(region_bits<max_region_bits&&
+          (std::size_t(1)<<region_bits)<segment_count)++region_bits;
+
+    std::size_t num_regions=std::size_t(1)<<region_bits;
+    hash_buffer order(n,boost::uint64_t(0),hash_allocator{get_allocator()}),
+                t2hash(
+                  array_length,boost::uint64_t(0),
+                  hash_allocator{get_allocator()}),
+                counts(hash_allocator{get_allocator()});
+    std::vector<unsigned char,count_allocator>
+                t2count(array_length,0,count_allocator{get_allocator()}),
+                reverse_h(n,0,count_allocator{get_allocator()});
+    std::vector<std::size_t,index_allocator>
+                alone(array_length,0,index_allocator{get_allocator()});
+    bool        deduplicated=false;
+
+    for(int attempt=0;;++attempt){
+      if(attempt==max_attempts){
+        BOOST_THROW_EXCEPTION(
+          std::runtime_error("binary fuse filter construction failed"));
+      }
+      seed=mulx64((boost::uint64_t)attempt);
+
+      std::size_t num_chunks=num_chunks_for(n),
+                  chunk_size=(n+num_chunks-1)/num_chunks;
+      counts.assign(num_chunks*num_regions,0);
+      sort_by_region(
+        hashes.data(),n,order.data(),counts.data(),
+        num_chunks,chunk_size,region_bits,ex);
+
+      if(peel(
+        order.data(),n,t2hash.data(),t2count.data(),
+        reverse_h.data(),alone.data())){
+        assign(order.data(),reverse_h.data(),n);
+        return;
+      }
+
+      std::fill(t2hash.begin(),t2hash.end(),boost::uint64_t(0));
+      std::fill(t2count.begin(),t2count.end(),(unsigned char)0);
+      if(!deduplicated){
+        std::sort(hashes.begin(),hashes.end());
+        hashes.erase(std::unique(hashes.begin(),hashes.end()),hashes.end());
+        n=hashes.size();
+        deduplicated=true;
+      }
+    }
+  }
+
+  /* stable counting sort of the remixed hash values by their high bits,
+   * which determine their first segment, so that the accesses of the
+   * peeling phase are roughly sequential
+   */
+
+  template<typename Executor>
+  void sort_by_region(
+    const boost::uint64_t* hashes,std::size_t n,boost::uint64_t* res,
+    boost::uint64_t* counts,std::size_t num_chunks,std::size_t chunk_size,
+    int region_bits,Executor& ex)const
+  {
+    std::size_t num_regions=std::size_t(1)<<region_bits;
+    auto        region=[&](boost::uint64_t h)->std::size_t{
+      return region_bits?(std::size_t)(h>>(64-region_bits)):0;
+    };
+
+    ex(num_chunks,[&,this](std::size_t j){
+      auto cnt=counts+j*num_regions;
+      for(std::size_t i=j*chunk_size,
+          last=(std::min)(i+chunk_size,n);i<last;++i){
+        ++cnt[region(remix(hashes[i],seed))];
+      }
+    });
+
+    boost::uint64_t acc=0;
+    for(std::size_t r=0;r<num_regions;++r){
+      for(std::size_t j=0;j<num_chunks;++j){
+        auto& cnt=counts[j*num_regions+r];
+        auto  c=cnt;
+        cnt=acc;
+        acc+=c;
+      }
+    }
+
+    ex(num_chunks,[&,this](std::size_t j){
+      auto cnt=counts+j*num_regions;
+      for(std::size_t i=j*chunk_size,
+          last=(std::min)(i+chunk_size,n);i<last;++i){
+        auto h=remix(hashes[i],seed);
+        res[cnt[region(h)]++]=h;
+      }
+    });
+  }
+
+  /* Each slot keeps the XOR of the hash values mapped to it, and a count
+   * (upper 6 bits) along with the XOR of the indices (0, 1, 2) of the slot
+   * within the positions of each of these hash values (lower 2 bits).
+   * Slots with a count of one are repeatedly peeled off, pushing the hash
+   * value and slot index on a stack that overwrites order.
+   */
+
+  bool peel(
+    boost::uint64_t* order,std::size_t n,boost::uint64_t* t2hash,
+    unsigned char* t2count,unsigned char* reverse_h,std::size_t* alone)const
+  {
+    static constexpr unsigned char mod3[]={0,1,2,0,1};
+
+    std::size_t array_length=fingerprints.size();
+    bool        overflow=false;
+    for(std::size_t i=0;i<n;++i){
+      auto        h=order[i];
+      std::size_t pos[3];
+      positions(h,pos);
+      for(unsigned char s=0;s<3;++s){
+        auto& c=t2count[pos[s]];
+        c=(unsigned char)((c+4)^s);
+        t2hash[pos[s]]^=h;
+        overflow|=c<4;
+      }
+    }
+    if(overflow)return false;
+
+    std::size_t qsize=0;
+    for(std::size_t i=0;i<array_length;++i){
+      alone[qsize]=i;
+      qsize+=(t2count[i]>>2)==1;
+    }
+
+    std::size_t stack_size=0;
+    while(qsize>0){
+      auto index=alone[--qsize];
+      if((t2count[index]>>2)!=1)continue;
+
+      auto          h=t2hash[index];
+      unsigned char found=t2count[index]&3;
+      reverse_h[stack_size]=found;
+      order[stack_size]=h;
+      ++stack_size;
+
+      std::size_t pos[5];
+      positions(h,pos);
+      pos[3]=pos[0];
+      pos[4]=pos[1];
+      for(unsigned char s=1;s<3;++s){
+        auto other=pos[found+s];
+        auto& c=t2count[other];
+        alone[qsize]=other;
+        qsize+=(c>>2)==2;
+        c=(unsigned char)((c-4)^mod3[found+s]);
+        t2hash[other]^=h;
+      }
+    }
+    return stack_size==n;
+  }
+
+  void assign(
+    const boost::uint64_t* order,const unsigned char* reverse_h,
+    std::size_t n)
+  {
+    auto p=fingerprints.data();
+    for(std::size_t i=n;i--;){
+      auto        h=order[i];
+      std::size_t pos[5];
+      positions(h,pos);
+      pos[3]=pos[0];
+      pos[4]=pos[1];
+      auto found=reverse_h[i];
+      p[pos[found]]=(fingerprint_type)(
+        fingerprint(h)^p[pos[found+1]]^p[pos[found+2]]);
+    }
+  }
+
+  using fingerprint_array=
+    std::vector<fingerprint_type,fingerprint_allocator>;
+
+  boost::uint64_t   seed=0;
+  std::size_t       segment_length=0;
+  std::size_t       segment_length_mask=0;
+  boost::uint64_t   segment_count_length=0;
+  fingerprint_array fingerprints;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -23,6 +23,13 @@ struct multiblock_fpr_base
   {
     return std::pow(1.0-std::pow(1.0-(double)K/w,(double)i),(double)K);
   }
+
+  /* expected number of distinct bits set by a mark on a w-bit block */
+
+  static double marked_bits(std::size_t)
+  {
+    return (double)K;
+  }
 };
 
 } /* namespace detail */
@@ -0,0 +1,183 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_NUMA_HPP
+#define BOOST_BLOOM_DETAIL_NUMA_HPP
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#if defined(SYS_mbind)
+#include <sched.h>
+#include <unistd.h>
+#include <climits>
+#include <fstream>
+#include <string>
+#include <vector>
+#define BOOST_BLOOM_NUMA
+#endif
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Minimal NUMA support on Linux without depending on libnuma: node and CPU
+ * topology is read from sysfs and memory policies are set by invoking the
+ * mbind system call directly. On other platforms, the system is regarded as
+ * having a single node and placement functions do nothing.
+ */
+
+#if defined(BOOST_BLOOM_NUMA)
+/* constants from <linux/mempolicy.h> */
+
+static constexpr int      numa_mpol_preferred=1;
+static constexpr int      numa_mpol_interleave=3;
+static constexpr unsigned numa_mpol_mf_move=1u<<1;
+
+static constexpr std::size_t numa_max_nodes=1024;
+static constexpr std::size_t numa_ulong_bits=sizeof(unsigned long)*CHAR_BIT;
+
+/* invokes f(i) for each i in a sysfs list like "0-3,8,10-11" */
+
+template<typename F>
+void numa_for_each_in_list(const std::string& path,F f)
+{
+  std::ifstream is(path);
+  unsigned long first,last;
+  char          c;
+  while(is>>first){
+    last=first;
+    if(is.peek()=='-')is>>c>>last;
+    for(unsigned long i=first;i<=last;++i)f(i);
+    if(!(is>>c))break; /* skip ',' */
+  }
+}
+
+struct numa_topology
+{
+  numa_topology()
+  {
+    numa_for_each_in_list(
+      "/sys/devices/system/node/online",
+      [this](unsigned long n){
+        if(n<numa_max_nodes&&n>=num_nodes)num_nodes=n+1;
+      });
+    for(std::size_t n=0;n<num_nodes;++n){
+      numa_for_each_in_list(
+        "/sys/devices/system/node/node"+std::to_string(n)+"/cpulist",
+        [&,this](unsigned long cpu){
+          if(cpu>=cpu_to_node.size())cpu_to_node.resize(cpu+1,0);
+          cpu_to_node[cpu]=n;
+        });
+    }
+  }
+
+  std::size_t              num_nodes=1;
+  std::vector<std::size_t> cpu_to_node;
+};
+
+inline const numa_topology& numa_get_topology()
+{
+  static const numa_topology t;
+  return t;
+}
+
+inline std::size_t numa_num_nodes()
+{
+  return numa_get_topology().num_nodes;
+}
+
+inline std::size_t numa_node_of_cpu(std::size_t cpu)
+{
+  const auto& t=numa_get_topology();
+  return cpu<t.cpu_to_node.size()?t.cpu_to_node[cpu]:0;
+}
+
+/* Returns the NUMA node the calling thread is running on or, if the system
+ * has only one node, its CPU number. sched_getcpu is cheap, but invoking it
+ * on every lookup prevents out-of-order execution from overlapping
+ * successive lookups, so the result is cached per thread and refreshed every
+ * numa_locality_refresh_period calls: a stale value (the thread has migrated
+ * in the meantime) only affects performance.
+ */
+
+static constexpr unsigned numa_locality_refresh_period=1024;
+
+struct numa_locality_cache
+{
+  std::size_t locality=0;
+  unsigned    countdown=0;
+};
+
+inline std::size_t numa_current_locality()
+{
+  static thread_local numa_locality_cache cache;
+
+  if(BOOST_UNLIKELY(cache.countdown--==0)){
+    cache.countdown=numa_locality_refresh_period-1;
+    int         n=sched_getcpu();
+    std::size_t cpu=n>=0?static_cast<std::size_t>(n):0;
+    cache.locality=numa_num_nodes()>1?numa_node_of_cpu(cpu):cpu;
+  }
+  return cache.locality;
+}
+
+/* mbind requires page-aligned addresses: only the pages entirely contained
+ * in [p,p+n) are affected so as not to change the policy of unrelated
+ * memory. Failure is ignored, as placement is merely an optimization.
+ */
+
+inline void numa_mbind(
+  void* p,std::size_t n,int mode,const unsigned long* mask,unsigned flags)
+{
+  static const std::size_t page=
+    static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+  auto first=(reinterpret_cast<boost::uintptr_t>(p)+page-1)/page*page,
+       last=(reinterpret_cast<boost::uintptr_t>(p)+n)/page*page;
+  if(first>=last)return;
+  (void)syscall(
+    SYS_mbind,first,last-first,mode,mask,
+    (unsigned long)numa_max_nodes,flags);
+}
+
+inline void numa_interleave(void* p,std::size_t n)
+{
+  std::size_t num_nodes=numa_num_nodes();
+  if(num_nodes<2)return;
+
+  unsigned long mask[numa_max_nodes/numa_ulong_bits]={};
+  for(std::size_t i=0;i<num_nodes;++i){
+    mask[i/numa_ulong_bits]|=1ul<<(i%numa_ulong_bits);
+  }
+  numa_mbind(p,n,numa_mpol_interleave,mask,0);
+}
+
+inline void numa_move_to_node(void* p,std::size_t n,std::size_t node)
+{
+  if(numa_num_nodes()<2||node>=numa_max_nodes)return;
+
+  unsigned long mask[numa_max_nodes/numa_ulong_bits]={};
+  mask[node/numa_ulong_bits]|=1ul<<(node%numa_ulong_bits);
+  numa_mbind(p,n,numa_mpol_preferred,mask,numa_mpol_mf_move);
+}
+#else
+inline std::size_t numa_num_nodes()noexcept{return 1;}
+inline std::size_t numa_current_locality()noexcept{return 0;}
+inline void        numa_interleave(void*,std::size_t)noexcept{}
+inline void        numa_move_to_node(void*,std::size_t,std::size_t)noexcept{}
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
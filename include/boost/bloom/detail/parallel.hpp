@@ -0,0 +1,121 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_PARALLEL_HPP
+#define BOOST_BLOOM_DETAIL_PARALLEL_HPP
+
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/type_traits/make_void.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/* BOOST_BLOOM_PARALLEL_ALGORITHMS is defined when the standard execution
+ * policies of <execution> are available, in which case they can be used
+ * wherever the library accepts an executor.
+ */
+
+#if !defined(BOOST_BLOOM_PARALLEL_ALGORITHMS)&& \
+    BOOST_CXX_VERSION>=201703L&&defined(__has_include)
+#if __has_include(<execution>)
+#include <execution>
+#if defined(__cpp_lib_execution)&&defined(__cpp_lib_parallel_algorithm)
+#define BOOST_BLOOM_PARALLEL_ALGORITHMS
+#endif
+#endif
+#endif
+
+#if defined(BOOST_BLOOM_PARALLEL_ALGORITHMS)
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* An executor is a function object ex such that ex(n,f) invokes f(i) for
+ * every i in [0,n), possibly concurrently, and returns when all the
+ * invocations have completed. Standard execution policies are adapted to
+ * this interface through std::for_each.
+ */
+
+struct executor_archetype_function
+{
+  void operator()(std::size_t)const{}
+};
+
+template<typename Executor,typename=void>
+struct is_executor_function:std::false_type{};
+
+template<typename Executor>
+struct is_executor_function<
+  Executor,
+  boost::void_t<decltype(std::declval<Executor&>()(
+    std::size_t(0),executor_archetype_function{}))>
+>:std::true_type{};
+
+#if defined(BOOST_BLOOM_PARALLEL_ALGORITHMS)
+
+template<typename ExecutionPolicy>
+struct execution_policy_executor
+{
+  template<typename F>
+  void operator()(std::size_t n,F f)const
+  {
+    std::vector<std::size_t> indices(n);
+    std::iota(indices.begin(),indices.end(),std::size_t(0));
+    std::for_each(policy,indices.begin(),indices.end(),f);
+  }
+
+  const ExecutionPolicy& policy;
+};
+
+template<typename Executor>
+struct is_executor:std::integral_constant<
+  bool,
+  is_executor_function<Executor>::value||
+  std::is_execution_policy<Executor>::value
+>{};
+
+template<
+  typename ExecutionPolicy,
+  typename std::enable_if<
+    std::is_execution_policy<ExecutionPolicy>::value>::type* =nullptr
+>
+execution_policy_executor<ExecutionPolicy>
+make_executor(const ExecutionPolicy& policy)
+{
+  return {policy};
+}
+#else
+template<typename Executor>
+struct is_executor:is_executor_function<Executor>{};
+#endif
+
+template<
+  typename Executor,
+  typename std::enable_if<is_executor_function<Executor>::value>::type* =
+    nullptr
+>
+Executor& make_executor(Executor& ex)
+{
+  return ex;
+}
+
+template<typename Executor>
+using enable_if_executor_t=typename std::enable_if<
+  is_executor<remove_cvref_t<Executor>>::value
+>::type;
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,134 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_RUNTIME_DISPATCH_HPP
+#define BOOST_BLOOM_DETAIL_RUNTIME_DISPATCH_HPP
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+/* When BOOST_BLOOM_ENABLE_RUNTIME_DISPATCH is defined by the user,
+ * fast_multiblock32 and fast_multiblock64 select their SIMD kernel at run
+ * time based on the capabilities of the host CPU (x64 only). Kernels
+ * are compiled with function-level target attributes, so no special
+ * compiler flags are needed.
+ */
+
+#if defined(BOOST_BLOOM_ENABLE_RUNTIME_DISPATCH)&& \
+    (defined(__x86_64__)||defined(_M_X64))&& \
+    ((defined(BOOST_GCC)&&BOOST_GCC>=40900)||defined(BOOST_CLANG)|| \
+     defined(BOOST_MSVC))
+#define BOOST_BLOOM_RUNTIME_DISPATCH
+#endif
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#include <immintrin.h>
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+#include <cpuid.h>
+#define BOOST_BLOOM_AVX2_TARGET __attribute__((target("avx2")))
+#define BOOST_BLOOM_AVX512_TARGET \
+__attribute__((target("avx2,avx512f,avx512bw")))
+#else
+#include <intrin.h>
+#endif
+#endif
+
+#if !defined(BOOST_BLOOM_AVX2_TARGET)
+#define BOOST_BLOOM_AVX2_TARGET
+#endif
+#if !defined(BOOST_BLOOM_AVX512_TARGET)
+#define BOOST_BLOOM_AVX512_TARGET
+#endif
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+enum class simd_level{generic=0,avx2,avx512};
+
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+
+inline void cpuid(unsigned int leaf,unsigned int (&regs)[4])
+{
+  __cpuid_count(leaf,0,regs[0],regs[1],regs[2],regs[3]);
+}
+
+inline boost::uint64_t xgetbv0()
+{
+  unsigned int lo,hi;
+  __asm__ __volatile__("xgetbv":"=a"(lo),"=d"(hi):"c"(0));
+  return ((boost::uint64_t)hi<<32)|lo;
+}
+
+#else
+
+inline void cpuid(unsigned int leaf,unsigned int (&regs)[4])
+{
+  int r[4];
+  __cpuidex(r,(int)leaf,0);
+  for(int i=0;i<4;++i)regs[i]=(unsigned int)r[i];
+}
+
+inline boost::uint64_t xgetbv0()
+{
+  return (boost::uint64_t)_xgetbv(0);
+}
+
+#endif
+
+inline simd_level detect_simd_level()
+{
+  unsigned int regs[4];
+
+  cpuid(0,regs);
+  if(regs[0]<7)return simd_level::generic;
+  cpuid(1,regs);
+  if(!(regs[2]&(1u<<27)))return simd_level::generic; /* no OSXSAVE */
+
+  /* the OS must preserve the SSE, AVX (and AVX-512) register state */
+
+  boost::uint64_t xcr0=xgetbv0();
+  if((xcr0&0x06)!=0x06)return simd_level::generic;
+
+  cpuid(7,regs);
+  bool avx2=regs[1]&(1u<<5),
+       avx512f=regs[1]&(1u<<16),
+       avx512bw=regs[1]&(1u<<30);
+  if(avx2&&avx512f&&avx512bw&&(xcr0&0xe0)==0xe0)return simd_level::avx512;
+  if(avx2)return simd_level::avx2;
+  return simd_level::generic;
+}
+
+/* cpuid is executed once at dynamic initialization time. Reading the
+ * level involves no initialization guard; before initialization, it is
+ * simd_level::generic, which is always valid (just slower) as all the
+ * kernels produce the same results.
+ */
+
+template<typename=void>
+struct runtime_simd_level_holder
+{
+  static const simd_level value;
+};
+
+template<typename T>
+const simd_level runtime_simd_level_holder<T>::value=detect_simd_level();
+
+inline simd_level runtime_simd_level()
+{
+  return runtime_simd_level_holder<>::value;
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
+#endif
@@ -0,0 +1,182 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_FAST_BLOCK_HPP
+#define BOOST_BLOOM_FAST_BLOCK_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/block_base.hpp>
+#include <boost/bloom/detail/block_fpr_base.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+namespace detail{
+
+template<std::size_t Bits>
+struct alignas(Bits/8) fast_block_value
+{
+  boost::uint64_t data[Bits/64];
+};
+
+} /* namespace detail */
+
+/* Like block, but the block is a Bits-wide SIMD register. Bit positions are
+ * selected exactly as in block (consecutive portions of the hash value,
+ * mixing it when exhausted), so the resulting arrays are the same with or
+ * without SIMD. The SIMD variants build the mask for bit position p in
+ * one go by shifting 1 left by p-32*i on each 32-bit lane i: lanes for
+ * which this amount falls outside [0,32) are left zero by sllv.
+ */
+
+template<std::size_t K,std::size_t Bits=256>
+struct fast_block:
+  private detail::block_base<detail::fast_block_value<Bits>,K>,
+  public detail::block_fpr_base<K>
+{
+  static_assert(Bits==256||Bits==512,"Bits must be 256 or 512");
+
+  static constexpr std::size_t k=K;
+  using value_type=detail::fast_block_value<Bits>;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,boost::uint64_t hash)
+  {
+    mark_impl(x,hash);
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,boost::uint64_t hash)
+  {
+    return check_impl(x,hash);
+  }
+
+private:
+  using super=detail::block_base<value_type,K>;
+  using super::mask;
+  using super::loop;
+
+#if defined(BOOST_BLOOM_AVX512)
+  static BOOST_FORCEINLINE void mark_impl(
+    detail::fast_block_value<512>& x,boost::uint64_t hash)
+  {
+    auto p=reinterpret_cast<__m512i*>(&x);
+    _mm512_store_si512(
+      p,_mm512_or_si512(_mm512_load_si512(p),make_m512i(hash)));
+  }
+
+  static BOOST_FORCEINLINE bool check_impl(
+    const detail::fast_block_value<512>& x,boost::uint64_t hash)
+  {
+    __m512i fp=make_m512i(hash),
+            y=_mm512_load_si512(reinterpret_cast<const __m512i*>(&x));
+    return _mm512_cmpneq_epi32_mask(_mm512_and_si512(y,fp),fp)==0;
+  }
+
+  static BOOST_FORCEINLINE __m512i make_m512i(boost::uint64_t hash)
+  {
+    const __m512i one=_mm512_set1_epi32(1),
+                  base=_mm512_set_epi32(
+                    480,448,416,384,352,320,288,256,
+                    224,192,160,128,96,64,32,0);
+    __m512i       fp=_mm512_setzero_si512();
+    loop(hash,[&](boost::uint64_t h){
+      fp=_mm512_or_si512(
+        fp,
+        _mm512_maskz_sllv_epi32(
+          (__mmask16)0xFFFFu,one,
+          _mm512_sub_epi32(_mm512_set1_epi32((int)(h&mask)),base)));
+    });
+    return fp;
+  }
+#endif
+
+#if defined(BOOST_BLOOM_AVX2)
+  /* with AVX-512, also used for Bits==256 */
+
+  static constexpr std::size_t num_m256i=Bits/256;
+
+  template<std::size_t N>
+  static BOOST_FORCEINLINE void mark_impl(
+    detail::fast_block_value<N>& x,boost::uint64_t hash)
+  {
+    __m256i fp[num_m256i];
+    make_m256i(hash,fp);
+    auto p=reinterpret_cast<__m256i*>(&x);
+    for(std::size_t i=0;i<num_m256i;++i){
+      _mm256_store_si256(
+        p+i,_mm256_or_si256(_mm256_load_si256(p+i),fp[i]));
+    }
+  }
+
+  template<std::size_t N>
+  static BOOST_FORCEINLINE bool check_impl(
+    const detail::fast_block_value<N>& x,boost::uint64_t hash)
+  {
+    __m256i fp[num_m256i];
+    make_m256i(hash,fp);
+    auto p=reinterpret_cast<const __m256i*>(&x);
+    int  res=1;
+    for(std::size_t i=0;i<num_m256i;++i){
+      res&=_mm256_testc_si256(_mm256_load_si256(p+i),fp[i]);
+    }
+    return res;
+  }
+
+  static BOOST_FORCEINLINE void make_m256i(
+    boost::uint64_t hash,__m256i (&fp)[num_m256i])
+  {
+    const __m256i one=_mm256_set1_epi32(1),
+                  base=_mm256_set_epi32(224,192,160,128,96,64,32,0),
+                  step=_mm256_set1_epi32(256);
+    for(std::size_t i=0;i<num_m256i;++i)fp[i]=_mm256_setzero_si256();
+    loop(hash,[&](boost::uint64_t h){
+      __m256i pos=_mm256_sub_epi32(_mm256_set1_epi32((int)(h&mask)),base);
+      for(std::size_t i=0;i<num_m256i;++i){
+        fp[i]=_mm256_or_si256(fp[i],_mm256_sllv_epi32(one,pos));
+        pos=_mm256_sub_epi32(pos,step);
+      }
+    });
+  }
+#else /* fallback */
+  static BOOST_FORCEINLINE void mark_impl(
+    value_type& x,boost::uint64_t hash)
+  {
+    loop(hash,[&](boost::uint64_t h){
+      auto n=h&mask;
+      x.data[n/64]|=boost::uint64_t(1)<<(n%64);
+    });
+  }
+
+  static BOOST_FORCEINLINE bool check_impl(
+    const value_type& x,boost::uint64_t hash)
+  {
+    value_type fp={};
+    mark_impl(fp,hash);
+    for(std::size_t i=0;i<Bits/64;++i){
+      if((x.data[i]&fp.data[i])!=fp.data[i])return false;
+    }
+    return true;
+  }
+#endif
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
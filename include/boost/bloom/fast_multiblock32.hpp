@@ -10,11 +10,56 @@
 #define BOOST_BLOOM_FAST_MULTIBLOCK32_HPP
 
 #include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
 #include <boost/bloom/detail/neon.hpp>
 #include <boost/bloom/detail/sse2.hpp>
 
-#if defined(BOOST_BLOOM_AVX2)
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#include <boost/bloom/detail/dispatched_subfilter.hpp>
+#include <boost/bloom/detail/fast_multiblock_generic.hpp>
 #include <boost/bloom/detail/fast_multiblock32_avx2.hpp>
+#include <boost/bloom/detail/fast_multiblock32_avx512.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock32:detail::dispatched_subfilter<
+  detail::fast_multiblock_generic<
+    boost::uint32_t,K,detail::fast_multiblock32_avx2<K>>,
+  detail::fast_multiblock32_avx2<K>,
+  detail::fast_multiblock32_avx512<K>
+>{};
+
+} /* namespace bloom */
+} /* namespace boost */
+#elif defined(BOOST_BLOOM_AVX512)
+#include <boost/bloom/detail/fast_multiblock32_avx512.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock32:detail::fast_multiblock32_avx512<K>{};
+
+} /* namespace bloom */
+} /* namespace boost */
+#elif defined(BOOST_BLOOM_AVX2) /* important that this comes after AVX512 */
+#include <boost/bloom/detail/fast_multiblock32_avx2.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock32:detail::fast_multiblock32_avx2<K>{};
+
+} /* namespace bloom */
+} /* namespace boost */
 #elif defined(BOOST_BLOOM_SSE2) /* important that this comes after AVX2 */
 #include <boost/bloom/detail/fast_multiblock32_sse2.hpp>
 #elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
@@ -10,9 +10,54 @@
 #define BOOST_BLOOM_FAST_MULTIBLOCK64_HPP
 
 #include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
 
-#if defined(BOOST_BLOOM_AVX2)
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#include <boost/bloom/detail/dispatched_subfilter.hpp>
+#include <boost/bloom/detail/fast_multiblock_generic.hpp>
 #include <boost/bloom/detail/fast_multiblock64_avx2.hpp>
+#include <boost/bloom/detail/fast_multiblock64_avx512.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock64:detail::dispatched_subfilter<
+  detail::fast_multiblock_generic<
+    boost::uint64_t,K,detail::fast_multiblock64_avx2<K>>,
+  detail::fast_multiblock64_avx2<K>,
+  detail::fast_multiblock64_avx512<K>
+>{};
+
+} /* namespace bloom */
+} /* namespace boost */
+#elif defined(BOOST_BLOOM_AVX512)
+#include <boost/bloom/detail/fast_multiblock64_avx512.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock64:detail::fast_multiblock64_avx512<K>{};
+
+} /* namespace bloom */
+} /* namespace boost */
+#elif defined(BOOST_BLOOM_AVX2) /* important that this comes after AVX512 */
+#include <boost/bloom/detail/fast_multiblock64_avx2.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+
+template<std::size_t K>
+struct fast_multiblock64:detail::fast_multiblock64_avx2<K>{};
+
+} /* namespace bloom */
+} /* namespace boost */
 #else /* fallback */
 #include <boost/bloom/multiblock.hpp>
 #include <boost/cstdint.hpp>
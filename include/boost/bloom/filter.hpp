@@ -12,16 +12,24 @@
 #define BOOST_BLOOM_FILTER_HPP
 
 #include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/compaction.hpp>
 #include <boost/bloom/detail/core.hpp>
 #include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/parallel.hpp>
 #include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/assert.hpp>
 #include <boost/config.hpp>
 #include <boost/container_hash/hash.hpp>
 #include <boost/core/allocator_traits.hpp>
 #include <boost/core/empty_value.hpp>
+#include <boost/core/span.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/unordered/hash_traits.hpp> // TODO: internalize?
+#include <algorithm>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -34,30 +42,52 @@ namespace detail{
  * mulx64_mix_policy uses the mulx64 function from
  * <boost/bloom/detail/mulx64.hpp>.
  *
- * filter mixes hash results with mulx64 if the hash is not marked as
- * avalanching, i.e. it's not of good quality (see
- * <boost/unordered/hash_traits.hpp>), or if std::size_t is less than 64 bits
- * (mixing policies promote to boost::uint64_t).
+ * mix_policy_for<Hash>, used by filter and static_filter, mixes hash
+ * results with mulx64 if the hash is not marked as avalanching, i.e. it's
+ * not of good quality (see <boost/unordered/hash_traits.hpp>), or if
+ * std::size_t is less than 64 bits (mixing policies promote to
+ * boost::uint64_t).
+ *
+ * mix(h,x) must be equivalent to mix(h(x)): this is relied upon by
+ * filter::mix_hash, which is part of the public interface.
  */
 
 struct no_mix_policy
 {
+  static inline boost::uint64_t mix(std::size_t hash)
+  {
+    return (boost::uint64_t)hash;
+  }
+
   template<typename Hash,typename T>
   static inline boost::uint64_t mix(const Hash& h,const T& x)
   {
-    return (boost::uint64_t)h(x);
+    return mix(h(x));
   }
 };
 
 struct mulx64_mix_policy
 {
+  static inline boost::uint64_t mix(std::size_t hash)
+  {
+    return mulx64((boost::uint64_t)hash);
+  }
+
   template<typename Hash,typename T>
   static inline boost::uint64_t mix(const Hash& h,const T& x)
   {
-    return mulx64((boost::uint64_t)h(x));
+    return mix(h(x));
   }
 };
 
+template<typename Hash>
+using mix_policy_for=typename std::conditional<
+  unordered::hash_is_avalanching<Hash>::value&&
+  sizeof(std::size_t)>=sizeof(boost::uint64_t),
+  no_mix_policy,
+  mulx64_mix_policy
+>::type;
+
 template<typename Allocator,typename T>
 class allocator_constructed
 {
@@ -95,10 +125,19 @@ private:
 #pragma warning(disable:4714) /* marked as __forceinline not inlined */
 #endif
 
+template<typename Filter> class scalable_filter;
+
+template<
+  typename T,std::size_t K,typename Subfilter,std::size_t BucketSize,
+  typename Hash,typename HashStrategy
+>
+class filter_view;
+
 template<
   typename T,std::size_t K,
   typename Subfilter=block<unsigned char,1>,std::size_t BucketSize=0,
-  typename Hash=boost::hash<T>,typename Allocator=std::allocator<T>
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<T>,
+  typename HashStrategy=mcg_and_fastrange
 >
 class
 
@@ -108,7 +147,8 @@ __declspec(empty_bases) /* activate EBO with multiple inheritance */
 
 filter:
   detail::filter_core<
-    K,Subfilter,BucketSize,allocator_rebind_t<Allocator,unsigned char>
+    K,Subfilter,BucketSize,allocator_rebind_t<Allocator,unsigned char>,
+    HashStrategy
   >,
   empty_value<Hash,0>
 {
@@ -117,14 +157,10 @@ filter:
     std::is_same<T,allocator_value_type_t<Allocator>>::value,
     "Allocator's value_type must be T");
   using super=detail::filter_core<
-    K,Subfilter,BucketSize,allocator_rebind_t<Allocator,unsigned char>
+    K,Subfilter,BucketSize,allocator_rebind_t<Allocator,unsigned char>,
+    HashStrategy
   >;
-  using mix_policy=typename std::conditional<
-    unordered::hash_is_avalanching<Hash>::value&&
-    sizeof(std::size_t)>=sizeof(boost::uint64_t),
-    detail::no_mix_policy,
-    detail::mulx64_mix_policy
-  >::type;
+  using mix_policy=detail::mix_policy_for<Hash>;
 
 public:
   using value_type=T;
@@ -133,6 +169,7 @@ public:
   using super::bucket_size;
   using hasher=Hash;
   using allocator_type=Allocator;
+  using hash_strategy=HashStrategy;
   using size_type=typename super::size_type;
   using difference_type=typename super::difference_type;
   using reference=value_type&;
@@ -172,6 +209,32 @@ public:
     insert(first,last);
   }
 
+  template<
+    typename Executor,typename RandomAccessIterator,
+    detail::enable_if_executor_t<Executor>* =nullptr
+  >
+  filter(
+    Executor&& ex,RandomAccessIterator first,RandomAccessIterator last,
+    std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    filter{m,h,al}
+  {
+    insert(std::forward<Executor>(ex),first,last);
+  }
+
+  template<
+    typename Executor,typename RandomAccessIterator,
+    detail::enable_if_executor_t<Executor>* =nullptr
+  >
+  filter(
+    Executor&& ex,RandomAccessIterator first,RandomAccessIterator last,
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    filter{n,fpr,h,al}
+  {
+    insert(std::forward<Executor>(ex),first,last);
+  }
+
   filter(const filter&)=default;
   filter(filter&&)=default;
 
@@ -256,6 +319,9 @@ public:
   using super::capacity;
   using super::capacity_for;
   using super::fpr_for;
+  using super::fill_ratio;
+  using super::estimated_size;
+  using super::estimated_fpr;
   using super::array;
 
   template<typename... Args>
@@ -292,7 +358,12 @@ public:
   template<typename InputIterator>
   void insert(InputIterator first,InputIterator last)
   {
-    while(first!=last)emplace(*first++);
+    super::bulk_insert([&,this](boost::uint64_t& hash)->bool{
+      if(first==last)return false;
+      hash=emplace_hash_for(*first);
+      ++first;
+      return true;
+    });
   }
 
   void insert(std::initializer_list<value_type> il)
@@ -300,6 +371,38 @@ public:
     insert(il.begin(),il.end());
   }
 
+  template<
+    typename Executor,typename RandomAccessIterator,
+    detail::enable_if_executor_t<Executor>* =nullptr
+  >
+  void insert(
+    Executor&& ex,RandomAccessIterator first,RandomAccessIterator last)
+  {
+    static_assert(
+      std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category
+      >::value,
+      "parallel insertion requires random-access iterators");
+
+    auto&& pex=detail::make_executor(ex);
+    super::parallel_insert(
+      (std::size_t)(last-first),
+      [&,this](std::size_t i){return emplace_hash_for(first[i]);},
+      pex);
+  }
+
+  template<typename InputIterator>
+  void insert_partitioned(InputIterator first,InputIterator last)
+  {
+    super::partitioned_insert([&,this](boost::uint64_t& hash)->bool{
+      if(first==last)return false;
+      hash=emplace_hash_for(*first);
+      ++first;
+      return true;
+    });
+  }
+
   void swap(filter& x)
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
@@ -312,6 +415,7 @@ public:
 
   using super::clear;
   using super::reset;
+  using super::fold;
 
   filter& operator&=(const filter& x)
   {
@@ -325,6 +429,52 @@ public:
     return *this;
   }
 
+  filter& operator^=(const filter& x)
+  {
+    super::operator^=(x);
+    return *this;
+  }
+
+  filter& operator-=(const filter& x)
+  {
+    super::operator-=(x);
+    return *this;
+  }
+
+  template<typename FilterIterator>
+  filter& union_with(FilterIterator first,FilterIterator last)
+  {
+    super::template multi_combine<detail::or_op>(first,last,get_super{});
+    return *this;
+  }
+
+  template<typename FilterIterator>
+  filter& intersection_with(FilterIterator first,FilterIterator last)
+  {
+    super::template multi_combine<detail::and_op>(first,last,get_super{});
+    return *this;
+  }
+
+  bool is_subset_of(const filter& x)const
+  {
+    return super::is_subset_of(x);
+  }
+
+  double estimated_intersection_size(const filter& x)const
+  {
+    return super::estimated_intersection_size(x);
+  }
+
+  double estimated_union_size(const filter& x)const
+  {
+    return super::estimated_union_size(x);
+  }
+
+  double jaccard_index(const filter& x)const
+  {
+    return super::jaccard_index(x);
+  }
+
   hasher hash_function()const
   {
     return h();
@@ -344,51 +494,298 @@ public:
     return super::may_contain(hash_for(x));
   }
 
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain(
+    InputIterator first,InputIterator last,OutputIterator res)const
+  {
+    return bulk_may_contain(first,last,res,element_hash{this});
+  }
+
+  void may_contain(
+    boost::span<const value_type> x,boost::span<bool> res)const
+  {
+    BOOST_ASSERT(res.size()>=x.size());
+    may_contain(x.begin(),x.end(),res.begin());
+  }
+
+  std::size_t may_contain_selection(
+    boost::span<const value_type> x,boost::span<boost::uint32_t> sel)const
+  {
+    static constexpr std::size_t N=detail::compaction_size();
+    static_assert(
+      N==super::bulk_lookup_size,"compaction and bulk lookup sizes differ");
+    BOOST_ASSERT(sel.size()>=x.size());
+    BOOST_ASSERT(
+      x.size()<=(std::size_t)(std::numeric_limits<boost::uint32_t>::max)());
+
+    boost::uint64_t hashes[N];
+    bool            results[N]={};
+    std::size_t     m=0;
+    for(std::size_t i=0;i<x.size();i+=N){
+      std::size_t n=(std::min)(N,x.size()-i);
+      for(std::size_t j=0;j<n;++j)hashes[j]=hash_for(x[i+j]);
+      super::bulk_may_contain(hashes,n,results);
+      m+=detail::compact_selection(
+        results,n,(boost::uint32_t)i,sel.data()+m);
+    }
+    return m;
+  }
+
+  void may_contain_bitmap(
+    boost::span<const value_type> x,boost::span<boost::uint64_t> bitmap)const
+  {
+    static constexpr std::size_t N=detail::compaction_size();
+    static_assert(
+      N==super::bulk_lookup_size,"compaction and bulk lookup sizes differ");
+    static_assert(64%N==0,"compaction size must divide 64");
+    BOOST_ASSERT(bitmap.size()>=(x.size()+63)/64);
+
+    boost::uint64_t hashes[N];
+    bool            results[N]={};
+    boost::uint64_t word=0;
+    for(std::size_t i=0;i<x.size();i+=N){
+      std::size_t n=(std::min)(N,x.size()-i);
+      for(std::size_t j=0;j<n;++j)hashes[j]=hash_for(x[i+j]);
+      super::bulk_may_contain(hashes,n,results);
+      word|=(boost::uint64_t)detail::bool_mask(results,n)<<(i%64);
+      if((i+N)%64==0||i+n==x.size()){
+        bitmap[i/64]=word;
+        word=0;
+      }
+    }
+  }
+
+  static boost::uint64_t mix_hash(std::size_t hash)
+  {
+    return mix_policy::mix(hash);
+  }
+
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE void insert_hash(boost::uint64_t hash)
+  {
+    super::insert(hash);
+  }
+
+  template<typename InputIterator>
+  void insert_hash(InputIterator first,InputIterator last)
+  {
+    super::bulk_insert([&](boost::uint64_t& hash)->bool{
+      if(first==last)return false;
+      hash=*first;
+      ++first;
+      return true;
+    });
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(boost::uint64_t hash)const
+  {
+    return super::may_contain(hash);
+  }
+
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain_hash(
+    InputIterator first,InputIterator last,OutputIterator res)const
+  {
+    return bulk_may_contain(first,last,res,[](boost::uint64_t hash){
+      return hash;
+    });
+  }
+
 private:
+  template<typename Filter> friend class scalable_filter;
+
+  template<
+    typename T1,std::size_t K1,typename S,std::size_t B,typename H,
+    typename HS
+  >
+  friend class filter_view;
+
+  template<typename FilterIterator,typename U>
+  friend void multi_insert(FilterIterator,FilterIterator,const U&);
+
+  template<typename FilterIterator,typename U,typename OutputIterator>
+  friend OutputIterator multi_may_contain(
+    FilterIterator,FilterIterator,const U&,OutputIterator);
+
   template<
-    typename T1,std::size_t K1,typename S,std::size_t B,typename H,typename A
+    typename T1,std::size_t K1,typename S,std::size_t B,typename H,typename A,
+    typename HS
   >
   bool friend operator==(
-    const filter<T1,K1,S,B,H,A>& x,const filter<T1,K1,S,B,H,A>& y);
+    const filter<T1,K1,S,B,H,A,HS>& x,const filter<T1,K1,S,B,H,A,HS>& y);
 
   using hash_base=empty_value<Hash,0>;
 
+  /* used by filter_view */
+
+  filter(
+    detail::external_array_t,const unsigned char* p,std::size_t m,
+    const hasher& h):
+    super{p,m,detail::external_array_t{}},hash_base{empty_init,h}{}
+
   const Hash& h()const{return hash_base::get();}
   Hash& h(){return hash_base::get();}
 
-  template<typename U>
-  inline boost::uint64_t hash_for(const U& x)const
+  struct get_super
   {
-    return mix_policy::mix(h(),x);
+    const super& operator()(const filter& x)const{return x;}
+  };
+
+  struct element_hash
+  {
+    template<typename U>
+    boost::uint64_t operator()(const U& x)const{return f->hash_for(x);}
+
+    const filter* f;
+  };
+
+  template<typename InputIterator,typename OutputIterator,typename HashFor>
+  OutputIterator bulk_may_contain(
+    InputIterator first,InputIterator last,OutputIterator res,
+    HashFor hash_for_)const
+  {
+    static constexpr std::size_t N=super::bulk_lookup_size;
+
+    boost::uint64_t hashes[N];
+    bool            results[N];
+    while(first!=last){
+      std::size_t n=0;
+      do{
+        hashes[n++]=hash_for_(*first);
+        ++first;
+      }while(n<N&&first!=last);
+      super::bulk_may_contain(hashes,n,results);
+      res=std::copy(results,results+n,res);
+    }
+    return res;
+  }
+
+  /* hash of the element that emplace(args...) would insert */
+
+  template<typename... Args>
+  inline boost::uint64_t emplace_hash_for(Args&&... args)const
+  {
+    return hash_for(detail::allocator_constructed<allocator_type,value_type>{
+      get_allocator(),std::forward<Args>(args)...}.value());
+  }
+
+  template<
+    typename U,
+    typename std::enable_if<
+      std::is_same<T,detail::remove_cvref_t<U>>::value>::type* =nullptr
+  >
+  inline boost::uint64_t emplace_hash_for(U&& x)const
+  {
+    return hash_for(x);
   }
 };
 
 template<
-  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
 >
-bool operator==(const filter<T,K,S,B,H,A>& x,const filter<T,K,S,B,H,A>& y)
+bool operator==(
+  const filter<T,K,S,B,H,A,HS>& x,const filter<T,K,S,B,H,A,HS>& y)
 {
-  using super=typename filter<T,K,S,B,H,A>::super;
+  using super=typename filter<T,K,S,B,H,A,HS>::super;
   return static_cast<const super&>(x)==static_cast<const super&>(y);
 }
 
 template<
-  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
 >
-bool operator!=(const filter<T,K,S,B,H,A>& x,const filter<T,K,S,B,H,A>& y)
+bool operator!=(
+  const filter<T,K,S,B,H,A,HS>& x,const filter<T,K,S,B,H,A,HS>& y)
 {
   return !(x==y);
 }
 
 template<
-  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
 >
-void swap(filter<T,K,S,B,H,A>& x,filter<T,K,S,B,H,A>& y)
+void swap(filter<T,K,S,B,H,A,HS>& x,filter<T,K,S,B,H,A,HS>& y)
   noexcept(noexcept(x.swap(y)))
 {
   x.swap(y);
 }
 
+/* multi_insert and multi_may_contain calculate the hash of x only once
+ * and then prefetch the corresponding initial buckets of (up to
+ * bulk_lookup_size) filters before completing the operations on each
+ * filter.
+ */
+
+template<typename FilterIterator,typename U>
+void multi_insert(FilterIterator first,FilterIterator last,const U& x)
+{
+  using filter_type=typename std::iterator_traits<FilterIterator>::value_type;
+  using super=typename filter_type::super;
+  static constexpr std::size_t N=super::bulk_lookup_size;
+
+  if(first==last)return;
+
+  const boost::uint64_t hash=(*first).hash_for(x);
+  super*                fs[N];
+  unsigned char*        ps[N];
+  boost::uint64_t       hashes[N];
+  while(first!=last){
+    std::size_t n=0;
+    do{
+      fs[n]=&static_cast<super&>(*first);
+      hashes[n]=hash;
+      ps[n]=fs[n]->prepare_insert(hashes[n]);
+      ++n;
+      ++first;
+    }while(n<N&&first!=last);
+    for(std::size_t i=0;i<n;++i)fs[i]->resume_insert(ps[i],hashes[i]);
+  }
+}
+
+template<typename FilterIterator,typename U,typename OutputIterator>
+OutputIterator multi_may_contain(
+  FilterIterator first,FilterIterator last,const U& x,OutputIterator res)
+{
+  using filter_type=typename std::iterator_traits<FilterIterator>::value_type;
+  using super=typename filter_type::super;
+  static constexpr std::size_t N=super::bulk_lookup_size;
+
+  if(first==last)return res;
+
+  const boost::uint64_t hash=(*first).hash_for(x);
+  const super*          fs[N];
+  const unsigned char*  ps[N];
+  boost::uint64_t       hashes[N];
+  while(first!=last){
+    std::size_t n=0;
+    do{
+      fs[n]=&static_cast<const super&>(*first);
+      hashes[n]=hash;
+      ps[n]=fs[n]->prepare_may_contain(hashes[n]);
+      ++n;
+      ++first;
+    }while(n<N&&first!=last);
+    for(std::size_t i=0;i<n;++i){
+      *res++=fs[i]->resume_may_contain(ps[i],hashes[i]);
+    }
+  }
+  return res;
+}
+
 #if defined(BOOST_MSVC)
 #pragma warning(pop) /* C4714 */
 #endif
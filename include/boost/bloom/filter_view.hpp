@@ -0,0 +1,195 @@
+/* Read-only Bloom filter over an external array.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_FILTER_VIEW_HPP
+#define BOOST_BLOOM_FILTER_VIEW_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/span.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Allocator for filters over non-owned arrays, which are never allocated
+ * nor deallocated by the filter.
+ */
+
+template<typename T>
+struct external_array_allocator
+{
+  using value_type=T;
+  using propagate_on_container_copy_assignment=std::true_type;
+  using propagate_on_container_move_assignment=std::true_type;
+  using propagate_on_container_swap=std::true_type;
+  using is_always_equal=std::true_type;
+
+  external_array_allocator()=default;
+  template<typename U>
+  external_array_allocator(const external_array_allocator<U>&)noexcept{}
+
+  T* allocate(std::size_t) /* never called */
+  {
+    BOOST_THROW_EXCEPTION(std::bad_alloc());
+  }
+
+  void deallocate(T*,std::size_t)noexcept{}
+
+  template<typename U>
+  friend bool operator==(
+    const external_array_allocator&,const external_array_allocator<U>&)
+  {
+    return true;
+  }
+
+  template<typename U>
+  friend bool operator!=(
+    const external_array_allocator&,const external_array_allocator<U>&)
+  {
+    return false;
+  }
+};
+
+} /* namespace detail */
+
+/* filter_view offers the lookup interface of the equivalent filter over
+ * an array it doesn't own, e.g. a memory-mapped file holding a previously
+ * saved array, so that no allocation or copying is needed to start using it.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t BucketSize=0,
+  typename Hash=boost::hash<T>,typename HashStrategy=mcg_and_fastrange
+>
+class filter_view:
+  filter<
+    T,K,Subfilter,BucketSize,Hash,detail::external_array_allocator<T>,
+    HashStrategy>
+{
+  using super=filter<
+    T,K,Subfilter,BucketSize,Hash,detail::external_array_allocator<T>,
+    HashStrategy>;
+  using block_type=typename Subfilter::value_type;
+
+public:
+  using value_type=T;
+  using super::k;
+  using subfilter=typename super::subfilter;
+  using super::bucket_size;
+  using hasher=Hash;
+  using hash_strategy=HashStrategy;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+
+  /* lookups may read this number of bytes past the end of the array
+   * (their values are irrelevant)
+   */
+
+  static constexpr std::size_t trailing_padding=
+    sizeof(block_type)-detail::used_value_size<Subfilter>::value;
+
+  filter_view()=default;
+
+  filter_view(
+    const unsigned char* p,std::size_t m,const hasher& h=hasher()):
+    super{detail::external_array_t{},p,m,h}{}
+
+  template<typename Allocator>
+  explicit filter_view(
+    const filter<
+      T,K,Subfilter,BucketSize,Hash,Allocator,HashStrategy>& f):
+    filter_view{f.array().data(),f.capacity(),f.hash_function()}{}
+
+  filter_view(const filter_view& x):
+    filter_view{x.array().data(),x.capacity(),x.hash_function()}{}
+
+  filter_view& operator=(const filter_view& x)
+  {
+    filter_view tmp{x};
+    super::swap(tmp);
+    return *this;
+  }
+
+  using super::capacity;
+  using super::capacity_for;
+  using super::fpr_for;
+  using super::fill_ratio;
+  using super::estimated_size;
+  using super::estimated_fpr;
+
+  boost::span<const unsigned char> array()const noexcept
+  {
+    return super::array();
+  }
+
+  /* asks the OS to read the array ahead asynchronously */
+
+  void advise_willneed()const noexcept
+  {
+#if defined(BOOST_HAS_UNISTD_H)&&defined(POSIX_MADV_WILLNEED)
+    auto s=array();
+    if(s.empty())return;
+    auto page=(boost::uintptr_t)page_size(),
+         first=(boost::uintptr_t)s.data()/page*page,
+         last=(boost::uintptr_t)(s.data()+s.size());
+    (void)posix_madvise((void*)first,last-first,POSIX_MADV_WILLNEED);
+#endif
+  }
+
+  /* reads one byte per memory page so that subsequent lookups don't incur
+   * page faults; can be run in a separate thread concurrently with lookups
+   */
+
+  void warm_up()const noexcept
+  {
+    auto                   page=page_size();
+    auto                   s=array();
+    volatile unsigned char x=0;
+    for(std::size_t i=0;i<s.size();i+=page)x=x+s[i];
+    (void)x;
+  }
+
+  using super::hash_function;
+  using super::hash_for;
+  using super::mix_hash;
+  using super::may_contain;
+  using super::may_contain_selection;
+  using super::may_contain_bitmap;
+  using super::may_contain_hash;
+
+private:
+  static std::size_t page_size()noexcept
+  {
+#if defined(BOOST_HAS_UNISTD_H)
+    long n=sysconf(_SC_PAGESIZE);
+    if(n>0)return (std::size_t)n;
+#endif
+    return 4096;
+  }
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
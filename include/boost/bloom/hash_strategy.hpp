@@ -0,0 +1,237 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_HASH_STRATEGY_HPP
+#define BOOST_BLOOM_HASH_STRATEGY_HPP
+
+#include <boost/bloom/detail/constexpr_bit_width.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace boost{
+namespace bloom{
+
+/* A hash strategy HS maps the (mixed) hash value of an element to the K
+ * positions in [0,HS{m}.range()) of the buckets visited upon insertion and
+ * lookup:
+ *   - HS{m} is constexpr, and range()>=m (range()>0 for m==0).
+ *   - prepare_hash(hash) is called once per element.
+ *   - next_position(hash) is called K times, returns the next position and
+ *     updates hash, which is then passed to the subfilter.
+ *   - Optionally, HS::foldable is true if, for range()==2*r, HS{r} yields
+ *     the same hash values and positions pos/2 instead of pos.
+ * As next_position only depends on hash, the entire sequence of positions
+ * is determined by the initial value of hash.
+ */
+
+/* mcg_and_fastrange produces (pos,hash') from hash, where
+ *   - m=mulx64(hash,range), mulx64 denotes extended multiplication
+ *   - pos=high(m)
+ *   - hash'=low(m)
+ *  pos is uniformly distributed in [0,range) (see
+ *  https://arxiv.org/pdf/1805.10941), whereas hash'<-hash is a multiplicative
+ *  congruential generator of the form hash'<-hash*rng mod 2^64. This MCG
+ *  generates long cycles when the initial value of hash is odd and
+ *  rng = +-3 (mod 8), which is why we adjust hash and rng as seen below. As a
+ *  result, the low bits of hash' are of poor quality, and the least
+ *  significant bit in particular is always one.
+ */
+
+struct mcg_and_fastrange
+{
+  constexpr mcg_and_fastrange(std::size_t m)noexcept:
+    rng{
+      m+(
+        (m%8<=3)?3-(m%8):
+        (m%8<=5)?5-(m%8):
+                 8-(m%8)+3)
+    }
+    {}
+
+  inline constexpr std::size_t range()const noexcept{return (std::size_t)rng;}
+
+  inline void prepare_hash(boost::uint64_t& hash)const noexcept
+  {
+    hash|=1u;
+  }
+
+  inline std::size_t next_position(boost::uint64_t& hash)const noexcept
+  {
+    boost::uint64_t hi;
+    hash=detail::umul128(hash,rng,hi);
+    return (std::size_t)hi;
+  }
+
+  boost::uint64_t rng;
+};
+
+/* mask_and_remix rounds the range up to a power of two 2^b and takes pos
+ * from the b most significant bits of hash, which is then advanced with
+ * the MCG hash'<-hash*c mod 2^64 (c = 5 (mod 8) from Steele and Vigna,
+ * https://arxiv.org/abs/2001.05304). Only a shift, a mask and a plain
+ * multiplication are needed, and pos and hash' can be computed in
+ * parallel, at the expense of up to doubling the capacity. Halving the
+ * range maps pos to pos/2 without changing hash', which makes filters
+ * foldable (see filter_core::fold).
+ */
+
+struct mask_and_remix
+{
+  constexpr mask_and_remix(std::size_t m)noexcept:
+    shift{bits(m)?64-(int)bits(m):63},
+    mask{(std::size_t(1)<<bits(m))-1}
+    {}
+
+  static constexpr bool foldable=true;
+
+  inline constexpr std::size_t range()const noexcept{return mask+1;}
+
+  inline void prepare_hash(boost::uint64_t& hash)const noexcept
+  {
+    hash|=1u;
+  }
+
+  inline std::size_t next_position(boost::uint64_t& hash)const noexcept
+  {
+    std::size_t pos=position(hash);
+    hash*=0xD1342543DE82EF95ull;
+    return pos;
+  }
+
+  int         shift;
+  std::size_t mask;
+
+private:
+  static constexpr std::size_t max_bits=
+    std::numeric_limits<std::size_t>::digits-1;
+
+  static constexpr std::size_t bits(std::size_t m)noexcept
+  {
+    return
+      m<=1?0:
+      detail::constexpr_bit_width(m-1)>max_bits?max_bits:
+      detail::constexpr_bit_width(m-1);
+  }
+
+  /* on 32-bit platforms, shift>=33, so only the high word is involved */
+
+  template<
+    typename SizeT=std::size_t,
+    typename std::enable_if<
+      sizeof(SizeT)>=sizeof(boost::uint64_t)>::type* =nullptr
+  >
+  inline std::size_t position(boost::uint64_t hash)const noexcept
+  {
+    return (std::size_t)(hash>>shift)&mask;
+  }
+
+  template<
+    typename SizeT=std::size_t,
+    typename std::enable_if<
+      sizeof(SizeT)<sizeof(boost::uint64_t)>::type* =nullptr
+  >
+  inline std::size_t position(boost::uint64_t hash)const noexcept
+  {
+    return (std::size_t)((boost::uint32_t)(hash>>32)>>(shift-32))&mask;
+  }
+};
+
+namespace detail{
+
+[[noreturn]] inline std::size_t throw_range_too_large()
+{
+  BOOST_THROW_EXCEPTION(
+    std::length_error("capacity too large for the hash strategy"));
+}
+
+constexpr std::size_t check_range32(std::size_t m)
+{
+  return (boost::uint64_t)m>((boost::uint64_t)1<<32)?
+    throw_range_too_large():
+    m?m:1;
+}
+
+inline constexpr std::size_t reduce32(
+  boost::uint32_t x,std::size_t rng)noexcept
+{
+  return (std::size_t)(((boost::uint64_t)x*rng)>>32);
+}
+
+} /* namespace detail */
+
+/* fastrange32 maps the high word of hash to [0,range) with a 32x32->64
+ * multiplication and then advances hash with the same MCG as
+ * mask_and_remix, so pos and hash' can be computed in parallel with native
+ * multiplications on 32-bit CPUs, where mcg_and_fastrange needs a full
+ * 64x64->128 multiplication per position. range is exactly m, which can't
+ * exceed 2^32: std::length_error is thrown otherwise.
+ */
+
+struct fastrange32
+{
+  constexpr fastrange32(std::size_t m):rng{detail::check_range32(m)}{}
+
+  inline constexpr std::size_t range()const noexcept{return rng;}
+
+  inline void prepare_hash(boost::uint64_t& hash)const noexcept
+  {
+    hash|=1u;
+  }
+
+  inline std::size_t next_position(boost::uint64_t& hash)const noexcept
+  {
+    std::size_t pos=detail::reduce32((boost::uint32_t)(hash>>32),rng);
+    hash*=0xD1342543DE82EF95ull;
+    return pos;
+  }
+
+  std::size_t rng;
+};
+
+/* double_hashing splits hash into h1=low(hash) and h2=high(hash) and
+ * produces the positions of c*(h1+i*h2) mod 2^32, i=0,...,K-1, mapped to
+ * [0,range) like fastrange32. This is double hashing as in Kirsch and
+ * Mitzenmacher, "Less Hashing, Same Performance: Building a Better Bloom
+ * Filter" (https://doi.org/10.1002/rsa.20208), with h1'=c*h1 and h2'=c*h2:
+ * multiplying by c keeps the bits of hash passed to the subfilter from
+ * being those that determine the position. Advancing hash is a single
+ * 32-bit addition, so positions don't wait on one another and the
+ * multiplications of all K rounds can be in flight simultaneously. h2 is
+ * not made odd, as the resulting shorter cycles of positions are
+ * irrelevant for any practical K. range is exactly m, which can't exceed
+ * 2^32: std::length_error is thrown otherwise.
+ */
+
+struct double_hashing
+{
+  constexpr double_hashing(std::size_t m):rng{detail::check_range32(m)}{}
+
+  inline constexpr std::size_t range()const noexcept{return rng;}
+
+  inline void prepare_hash(boost::uint64_t&)const noexcept{}
+
+  inline std::size_t next_position(boost::uint64_t& hash)const noexcept
+  {
+    auto        h1=(boost::uint32_t)hash;
+    std::size_t pos=detail::reduce32((boost::uint32_t)(h1*0x9E3779B1u),rng);
+    hash=(hash&0xFFFFFFFF00000000ull)|
+      (boost::uint32_t)(h1+(boost::uint32_t)(hash>>32));
+    return pos;
+  }
+
+  std::size_t rng;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,213 @@
+/* Allocator backed by huge memory pages.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_HUGE_PAGE_ALLOCATOR_HPP
+#define BOOST_BLOOM_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <boost/bloom/detail/numa.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define BOOST_BLOOM_HUGE_PAGES
+#endif
+
+namespace boost{
+namespace bloom{
+
+/* Flags controlling how huge_page_allocator obtains memory:
+ *   - huge_page_flags::explicit_huge_pages: try to allocate from the
+ *     preallocated pool of huge pages (MAP_HUGETLB) before resorting to
+ *     transparent huge pages.
+ *   - huge_page_flags::populate: prefault the memory on allocation
+ *     (MAP_POPULATE), so that first accesses don't incur page faults.
+ *   - huge_page_flags::lock: lock the memory into RAM (mlock), failure being
+ *     ignored.
+ *   - huge_page_flags::interleave: interleave the pages across all NUMA
+ *     nodes (mbind with MPOL_INTERLEAVE), so that memory accesses from
+ *     threads on different nodes are evenly spread among them.
+ */
+
+struct huge_page_flags
+{
+  static constexpr unsigned int none=0,
+                                explicit_huge_pages=1,
+                                populate=2,
+                                lock=4,
+                                interleave=8;
+};
+
+namespace detail{
+
+#if defined(BOOST_BLOOM_HUGE_PAGES)
+static constexpr std::size_t huge_page_size=std::size_t(2)<<20;
+static constexpr std::size_t small_page_size=4096;
+
+/* Allocations of at least huge_page_size bytes are rounded up to a multiple
+ * of huge_page_size and aligned to it (by overallocating and trimming), so
+ * that they can be backed entirely by huge pages; smaller ones are rounded up
+ * to a multiple of small_page_size. Without MAP_HUGETLB, madvise(MADV_HUGEPAGE)
+ * asks the kernel to use transparent huge pages for the region.
+ */
+
+inline std::size_t huge_page_rounded_size(std::size_t n)noexcept
+{
+  std::size_t page=n>=huge_page_size?huge_page_size:small_page_size;
+  return (n+page-1)/page*page;
+}
+
+inline void* huge_page_allocate(std::size_t n,unsigned int flags)
+{
+  static constexpr std::size_t max_size=
+    (std::numeric_limits<std::size_t>::max)()-2*huge_page_size;
+
+  if(n>max_size)BOOST_THROW_EXCEPTION(std::bad_alloc());
+  std::size_t size=huge_page_rounded_size(n?n:1);
+  int         mmap_flags=MAP_PRIVATE|MAP_ANONYMOUS,
+              populate_flag=0;
+  bool        prefault=flags&huge_page_flags::populate;
+#if defined(MAP_POPULATE)
+  /* pages can't be faulted before the NUMA policy is set */
+
+  if(prefault&&!(flags&huge_page_flags::interleave)){
+    populate_flag=MAP_POPULATE;
+  }
+#endif
+
+  void* p=MAP_FAILED;
+#if defined(MAP_HUGETLB)
+  if(size>=huge_page_size&&(flags&huge_page_flags::explicit_huge_pages)){
+    p=mmap(
+      nullptr,size,PROT_READ|PROT_WRITE,
+      mmap_flags|populate_flag|MAP_HUGETLB,-1,0);
+  }
+#endif
+  if(p!=MAP_FAILED){
+    /* got explicit huge pages */
+
+    if(populate_flag)prefault=false;
+  }
+  else if(size<huge_page_size){
+    p=mmap(nullptr,size,PROT_READ|PROT_WRITE,mmap_flags|populate_flag,-1,0);
+    if(p==MAP_FAILED)BOOST_THROW_EXCEPTION(std::bad_alloc());
+    if(populate_flag)prefault=false;
+  }
+  else{
+    /* overallocate and trim to huge_page_size alignment */
+
+    std::size_t total=size+huge_page_size;
+    auto        q=static_cast<unsigned char*>(
+                  mmap(nullptr,total,PROT_READ|PROT_WRITE,mmap_flags,-1,0));
+    if(q==MAP_FAILED)BOOST_THROW_EXCEPTION(std::bad_alloc());
+    std::size_t head=
+      (huge_page_size-boost::uintptr_t(q)%huge_page_size)%huge_page_size;
+    if(head)munmap(q,head);
+    munmap(q+head+size,total-head-size);
+    p=q+head;
+#if defined(MADV_HUGEPAGE)
+    madvise(p,size,MADV_HUGEPAGE);
+#endif
+  }
+  if(flags&huge_page_flags::interleave)numa_interleave(p,size);
+  if(prefault){
+    /* prefault by hand so that huge pages and the NUMA policy are used */
+
+    auto pp=static_cast<volatile unsigned char*>(p);
+    for(std::size_t i=0;i<size;i+=small_page_size)pp[i]=0;
+  }
+  if(flags&huge_page_flags::lock)mlock(p,size);
+  return p;
+}
+
+inline void huge_page_deallocate(void* p,std::size_t n)noexcept
+{
+  munmap(p,huge_page_rounded_size(n?n:1));
+}
+#endif
+
+} /* namespace detail */
+
+template<typename T>
+class huge_page_allocator
+{
+public:
+  using value_type=T;
+  using propagate_on_container_copy_assignment=std::true_type;
+  using propagate_on_container_move_assignment=std::true_type;
+  using propagate_on_container_swap=std::true_type;
+  using is_always_equal=std::true_type;
+
+#if defined(BOOST_BLOOM_HUGE_PAGES)
+  /* minimum alignment of the memory returned by allocate */
+  static constexpr std::size_t alignment=detail::small_page_size;
+#else
+  static constexpr std::size_t alignment=alignof(T);
+#endif
+
+  huge_page_allocator()=default;
+  explicit huge_page_allocator(unsigned int flags_)noexcept:flags{flags_}{}
+
+  template<typename U>
+  huge_page_allocator(const huge_page_allocator<U>& x)noexcept:
+    flags{x.flags}{}
+
+  T* allocate(std::size_t n)
+  {
+    if(n>(std::numeric_limits<std::size_t>::max)()/sizeof(T)){
+      BOOST_THROW_EXCEPTION(std::bad_alloc());
+    }
+#if defined(BOOST_BLOOM_HUGE_PAGES)
+    return static_cast<T*>(detail::huge_page_allocate(n*sizeof(T),flags));
+#else
+    return static_cast<T*>(::operator new(n*sizeof(T)));
+#endif
+  }
+
+  void deallocate(T* p,std::size_t n)noexcept
+  {
+#if defined(BOOST_BLOOM_HUGE_PAGES)
+    detail::huge_page_deallocate(p,n*sizeof(T));
+#else
+    (void)n;
+    ::operator delete(p);
+#endif
+  }
+
+  unsigned int get_flags()const noexcept{return flags;}
+
+  template<typename U>
+  friend bool operator==(
+    const huge_page_allocator&,const huge_page_allocator<U>&)noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  friend bool operator!=(
+    const huge_page_allocator&,const huge_page_allocator<U>&)noexcept
+  {
+    return false;
+  }
+
+private:
+  template<typename U> friend class huge_page_allocator;
+
+  unsigned int flags=huge_page_flags::none;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
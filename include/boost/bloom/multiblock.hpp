@@ -9,10 +9,14 @@
 #ifndef BOOST_BLOOM_MULTIBLOCK_HPP
 #define BOOST_BLOOM_MULTIBLOCK_HPP
 
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/batch_check.hpp>
 #include <boost/bloom/detail/block_base.hpp>
 #include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 #include <cstddef>
+#include <type_traits>
 
 namespace boost{
 namespace bloom{
@@ -44,6 +48,53 @@ private:
   using super::loop;
 };
 
+#if defined(BOOST_BLOOM_AVX2)
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+template<typename Block,std::size_t K>
+struct batch_check<
+  multiblock<Block,K>,
+  typename std::enable_if<sizeof(Block)==4||sizeof(Block)==8>::type
+>
+{
+  static constexpr std::size_t width=4;
+
+  static BOOST_FORCEINLINE int check(
+    const unsigned char* base,const boost::uint64_t* offsets,
+    const boost::uint64_t* hashes)
+  {
+    using block_base=detail::block_base<Block,K>;
+
+    const __m256i one=_mm256_set1_epi64x(1),
+                  mask=_mm256_set1_epi64x(block_base::mask);
+    const __m256i offs=
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets));
+    __m256i       res=one;
+    std::size_t   i=0;
+    loop_m256i<block_base>(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes)),
+      [&](__m256i h){
+        __m256i x=gather_m256i<Block>(base+sizeof(Block)*i++,offs);
+        res=_mm256_and_si256(
+          res,_mm256_srlv_epi64(x,_mm256_and_si256(h,mask)));
+      });
+    return _mm256_movemask_pd(_mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(_mm256_and_si256(res,one),one)));
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+#endif
+
 } /* namespace bloom */
 } /* namespace boost */
 #endif
@@ -0,0 +1,173 @@
+/* Bloom filter replicated across NUMA nodes.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_REPLICATED_FILTER_HPP
+#define BOOST_BLOOM_REPLICATED_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/detail/numa.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+
+/* replicated_filter<Filter> holds num_replicas() copies of a filter, each
+ * with its array placed on a different NUMA node (replica i goes to node
+ * i % number of nodes), and routes lookups to the replica local to the
+ * calling thread, so that they don't cross the interconnect. Writes can be
+ * either propagated immediately to all replicas (insert) or done only on the
+ * local replica (insert_local) and later merged with synchronize, which
+ * |='s all replicas together.
+ *
+ * The replica local to a thread running on CPU c is node(c) % num_replicas()
+ * or, if the system has only one node, c % num_replicas(): this way, the
+ * number of replicas can be set freely to simulate NUMA systems.
+ */
+
+template<typename Filter>
+class replicated_filter
+{
+  using replica_container=std::vector<Filter>;
+
+public:
+  using filter_type=Filter;
+  using value_type=typename Filter::value_type;
+  using size_type=std::size_t;
+
+  explicit replicated_filter(const Filter& f):
+    replicated_filter{f,detail::numa_num_nodes()}{}
+
+  replicated_filter(const Filter& f,size_type num_replicas)
+  {
+    if(num_replicas==0)num_replicas=1;
+    replicas.reserve(num_replicas);
+    for(size_type i=0;i<num_replicas;++i){
+      replicas.push_back(f);
+      place(i);
+    }
+  }
+
+  replicated_filter(const replicated_filter& x):
+    replicated_filter{x.replica(0),x.num_replicas()}
+  {
+    for(size_type i=1;i<num_replicas();++i)replicas[i]=x.replicas[i];
+  }
+
+  replicated_filter(replicated_filter&&)=default;
+  replicated_filter& operator=(const replicated_filter&)=delete;
+  replicated_filter& operator=(replicated_filter&&)=default;
+
+  size_type num_replicas()const noexcept{return replicas.size();}
+
+  size_type local_replica_index()const
+  {
+    /* avoids a costly division in the common case */
+
+    std::size_t i=detail::numa_current_locality();
+    return i<num_replicas()?i:i%num_replicas();
+  }
+
+  /* Replicas can be modified directly, but operations changing their
+   * capacity (assignment from a different filter, reset) lose their NUMA
+   * placement and make synchronize throw.
+   */
+
+  Filter& replica(size_type i)noexcept
+  {
+    BOOST_ASSERT(i<num_replicas());
+    return replicas[i];
+  }
+
+  const Filter& replica(size_type i)const noexcept
+  {
+    BOOST_ASSERT(i<num_replicas());
+    return replicas[i];
+  }
+
+  Filter&       local_replica(){return replicas[local_replica_index()];}
+  const Filter& local_replica()const{return replicas[local_replica_index()];}
+
+  size_type capacity()const noexcept{return replicas[0].capacity();}
+
+  template<typename U>
+  void insert(const U& x)
+  {
+    for(auto& f:replicas)f.insert(x);
+  }
+
+  /* [first,last) is traversed once per replica */
+
+  template<typename ForwardIterator>
+  void insert(ForwardIterator first,ForwardIterator last)
+  {
+    for(auto& f:replicas)f.insert(first,last);
+  }
+
+  template<typename U>
+  void insert_local(const U& x)
+  {
+    local_replica().insert(x);
+  }
+
+  template<typename InputIterator>
+  void insert_local(InputIterator first,InputIterator last)
+  {
+    local_replica().insert(first,last);
+  }
+
+  /* makes all replicas equal to the union of them */
+
+  void synchronize()
+  {
+    if(num_replicas()==1)return;
+    auto& f0=replicas[0];
+    f0.union_with(replicas.begin()+1,replicas.end());
+    for(size_type i=1;i<num_replicas();++i)replicas[i]=f0;
+  }
+
+  void clear()noexcept
+  {
+    for(auto& f:replicas)f.clear();
+  }
+
+  /* Routing adds a few instructions per lookup, which reduces the number
+   * of cache misses the CPU can overlap: in hot loops, use bulk lookup or
+   * cache local_replica().
+   */
+
+  template<typename U>
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return local_replica().may_contain(x);
+  }
+
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain(
+    InputIterator first,InputIterator last,OutputIterator res)const
+  {
+    return local_replica().may_contain(first,last,res);
+  }
+
+private:
+  void place(size_type i)
+  {
+    auto s=replicas[i].array();
+    detail::numa_move_to_node(
+      s.data(),s.size(),i%detail::numa_num_nodes());
+  }
+
+  replica_container replicas;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
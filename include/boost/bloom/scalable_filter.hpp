@@ -0,0 +1,232 @@
+/* Bloom filter growing with the number of elements inserted.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_SCALABLE_FILTER_HPP
+#define BOOST_BLOOM_SCALABLE_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+
+/* scalable_filter<Filter> is a chain of filters (stages) as described in
+ * Almeida et al., "Scalable Bloom Filters"
+ * (https://doi.org/10.1016/j.ipl.2006.10.007). Elements are inserted into
+ * the last stage until it holds the number of elements it was sized for,
+ * at which point a new stage is appended with growth times as many
+ * elements and its FPR multiplied by tightening. Stage i is sized with
+ * Filter::capacity_for(n*growth^i,fpr*(1-tightening)*tightening^i), so
+ * the compound FPR, 1-prod(1-fpr_i), stays below fpr no matter how many
+ * stages are added. Elements are counted on insertion, duplicates
+ * included.
+ *
+ * Lookup calculates the hash of the element once, prefetches the initial
+ * buckets of all the stages and then checks the stages from the newest
+ * (which holds most of the elements) backwards, so that the cache misses
+ * of the different stages overlap rather than add up.
+ */
+
+template<typename Filter>
+class scalable_filter
+{
+  using stage_container=std::vector<Filter>;
+  using super=typename Filter::super;
+
+public:
+  using filter_type=Filter;
+  using value_type=typename Filter::value_type;
+  using hasher=typename Filter::hasher;
+  using allocator_type=typename Filter::allocator_type;
+  using size_type=std::size_t;
+
+  scalable_filter(
+    size_type n,double fpr,double growth=2.0,double tightening=0.5,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    initial_n{n?n:1},fpr_{fpr},growth_{growth},tightening_{tightening}
+  {
+    if(!(fpr>0.0&&fpr<1.0)){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("fpr must be in (0,1)"));
+    }
+    if(!(growth>=1.0)){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("growth must be >= 1"));
+    }
+    if(!(tightening>0.0&&tightening<1.0)){
+      BOOST_THROW_EXCEPTION(
+        std::invalid_argument("tightening must be in (0,1)"));
+    }
+    stages.emplace_back(initial_n,stage_fpr(0),h,al);
+    stage_limit=initial_n;
+  }
+
+  size_type size()const noexcept{return size_;}
+  size_type num_stages()const noexcept{return stages.size();}
+
+  const Filter& stage(size_type i)const noexcept
+  {
+    BOOST_ASSERT(i<num_stages());
+    return stages[i];
+  }
+
+  double fpr()const noexcept{return fpr_;}
+  double growth()const noexcept{return growth_;}
+  double tightening()const noexcept{return tightening_;}
+
+  size_type capacity()const noexcept
+  {
+    size_type res=0;
+    for(const auto& f:stages)res+=f.capacity();
+    return res;
+  }
+
+  double estimated_fpr()const noexcept
+  {
+    double res=1.0;
+    for(const auto& f:stages)res*=1.0-f.estimated_fpr();
+    return 1.0-res;
+  }
+
+  template<typename U>
+  void insert(const U& x)
+  {
+    if(stage_size==stage_limit)add_stage();
+    stages.back().insert(x);
+    ++stage_size;
+    ++size_;
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    for(;first!=last;++first)insert(*first);
+  }
+
+  /* drops all the stages but the first one */
+
+  void clear()noexcept
+  {
+    stages.erase(stages.begin()+1,stages.end());
+    stages[0].clear();
+    stage_limit=initial_n;
+    stage_size=0;
+    size_=0;
+  }
+
+  template<typename U>
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    static constexpr std::size_t N=super::bulk_lookup_size;
+
+    const boost::uint64_t hash=stages[0].hash_for(x);
+    if(stages.size()==1)return stages[0].may_contain_hash(hash);
+
+    const super*          fs[N];
+    const unsigned char*  ps[N];
+    boost::uint64_t       hashes[N];
+    for(auto first=stages.rbegin(),last=stages.rend();first!=last;){
+      std::size_t n=0;
+      do{
+        fs[n]=&static_cast<const super&>(*first);
+        hashes[n]=hash;
+        ps[n]=fs[n]->prepare_may_contain(hashes[n]);
+        ++n;
+        ++first;
+      }while(n<N&&first!=last);
+      for(std::size_t i=0;i<n;++i){
+        if(fs[i]->resume_may_contain(ps[i],hashes[i]))return true;
+      }
+    }
+    return false;
+  }
+
+  /* Elements are processed in groups of bulk_lookup_size, stage by stage
+   * from the newest, with bulk lookup on the elements of the group not
+   * yet found positive.
+   */
+
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain(
+    InputIterator first,InputIterator last,OutputIterator res)const
+  {
+    static constexpr std::size_t N=super::bulk_lookup_size;
+
+    boost::uint64_t hashes[N],live_hashes[N];
+    std::size_t     live[N];
+    bool            results[N],stage_results[N];
+    while(first!=last){
+      std::size_t n=0;
+      do{
+        hashes[n]=stages[0].hash_for(*first);
+        results[n]=false;
+        live[n]=n;
+        ++n;
+        ++first;
+      }while(n<N&&first!=last);
+
+      std::size_t num_live=n;
+      for(auto it=stages.rbegin();it!=stages.rend()&&num_live;++it){
+        for(std::size_t j=0;j<num_live;++j)live_hashes[j]=hashes[live[j]];
+        it->may_contain_hash(live_hashes,live_hashes+num_live,stage_results);
+        std::size_t m=0;
+        for(std::size_t j=0;j<num_live;++j){
+          results[live[j]]=stage_results[j];
+          live[m]=live[j];
+          m+=!stage_results[j];
+        }
+        num_live=m;
+      }
+      res=std::copy(results,results+n,res);
+    }
+    return res;
+  }
+
+private:
+  double stage_fpr(std::size_t i)const
+  {
+    return fpr_*(1.0-tightening_)*std::pow(tightening_,(double)i);
+  }
+
+  void add_stage()
+  {
+    static constexpr double max_size=
+      (double)(std::numeric_limits<size_type>::max)()/2;
+
+    auto   i=stages.size();
+    double n=(double)initial_n*std::pow(growth_,(double)i);
+    auto   limit=n>=max_size?(size_type)max_size:(size_type)n;
+    auto   h=stages.back().hash_function();
+    auto   al=stages.back().get_allocator();
+    stages.emplace_back(limit,stage_fpr(i),h,al);
+    stage_limit=limit;
+    stage_size=0;
+  }
+
+  size_type       initial_n;
+  double          fpr_;
+  double          growth_;
+  double          tightening_;
+  stage_container stages;
+  size_type       stage_limit;   /* elements the last stage is sized for */
+  size_type       stage_size=0;  /* elements inserted into the last stage */
+  size_type       size_=0;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,880 @@
+/* Self-describing binary serialization of Bloom filters.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_SERIALIZATION_HPP
+#define BOOST_BLOOM_SERIALIZATION_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/atomic_subfilter.hpp>
+#include <boost/bloom/detail/compression.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/crc32c.hpp>
+#include <boost/bloom/fast_block.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/filter_view.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/core/span.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <cerrno>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+namespace boost{
+namespace bloom{
+
+namespace detail{
+
+/* ids assigned by the library have a family in [1,256) in bits 32-39 */
+
+constexpr boost::uint64_t make_library_id(
+  boost::uint64_t family,boost::uint64_t x)
+{
+  return family<<32|x;
+}
+
+/* hash_id_type_code<T>::value distinguishes the fundamental and standard
+ * string types T in the ids of boost::hash<T> and std::hash<T>; other
+ * types have code 0.
+ */
+
+template<typename T>
+struct hash_id_type_code:std::integral_constant<boost::uint64_t,0>{};
+
+#define BOOST_BLOOM_HASH_ID_TYPE_CODE(T,code)                    \
+template<>                                                       \
+struct hash_id_type_code<T>:                                     \
+  std::integral_constant<boost::uint64_t,code>{};
+
+BOOST_BLOOM_HASH_ID_TYPE_CODE(bool,1)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(char,2)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(signed char,3)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(unsigned char,4)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(wchar_t,5)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(char16_t,6)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(char32_t,7)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(short,8)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(unsigned short,9)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(int,10)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(unsigned int,11)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(long,12)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(unsigned long,13)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(long long,14)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(unsigned long long,15)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(float,16)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(double,17)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(long double,18)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(std::string,32)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(std::wstring,33)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(std::u16string,34)
+BOOST_BLOOM_HASH_ID_TYPE_CODE(std::u32string,35)
+
+#undef BOOST_BLOOM_HASH_ID_TYPE_CODE
+
+} /* namespace detail */
+
+/* hash_id<Hash>::value identifies the hash function stored in serialized
+ * filters so that loading into a filter with a different hash function
+ * fails. 0 means unspecified and can't be serialized: users must
+ * specialize hash_id for their hash functions with non-zero values
+ * outside the range [2^32,2^40) reserved for the library.
+ */
+
+template<typename Hash>
+struct hash_id:std::integral_constant<boost::uint64_t,0>{};
+
+template<typename T>
+struct hash_id<boost::hash<T>>:std::integral_constant<
+  boost::uint64_t,
+  detail::make_library_id(1,detail::hash_id_type_code<T>::value)>{};
+
+template<typename T>
+struct hash_id<std::hash<T>>:std::integral_constant<
+  boost::uint64_t,
+  detail::make_library_id(2,detail::hash_id_type_code<T>::value)>{};
+
+/* hash_strategy_id<HashStrategy>::value goes into the high byte of the
+ * flags field. mcg_and_fastrange is 0 so that filters with the default
+ * strategy keep their previous header. Values in [0,128) are reserved for
+ * the library; users must specialize hash_strategy_id for their strategies
+ * with values in [128,255) to serialize filters using them, as 255 means
+ * unspecified and positions computed by different strategies can't be told
+ * apart otherwise.
+ */
+
+template<typename HashStrategy>
+struct hash_strategy_id:std::integral_constant<boost::uint64_t,255>{};
+
+template<>
+struct hash_strategy_id<mcg_and_fastrange>:
+  std::integral_constant<boost::uint64_t,0>{};
+
+template<>
+struct hash_strategy_id<mask_and_remix>:
+  std::integral_constant<boost::uint64_t,1>{};
+
+template<>
+struct hash_strategy_id<fastrange32>:
+  std::integral_constant<boost::uint64_t,2>{};
+
+template<>
+struct hash_strategy_id<double_hashing>:
+  std::integral_constant<boost::uint64_t,3>{};
+
+enum class serialization_format{raw,compressed};
+
+namespace detail{
+
+constexpr boost::uint64_t make_subfilter_id(
+  boost::uint64_t family,std::size_t word_size,std::size_t k)
+{
+  return make_library_id(
+    family,(boost::uint64_t)word_size<<16|(boost::uint64_t)k);
+}
+
+} /* namespace detail */
+
+/* subfilter_id<Subfilter>::value encodes the family of Subfilter along with
+ * its word size and k. Implementations of fast_multiblock32/64 with
+ * different bit layouts (see fast_multiblock32.hpp) have different
+ * families; when no SIMD is available, they're aliases of multiblock and
+ * identified as such. As with hash_id, 0 means unspecified and users must
+ * specialize subfilter_id for their subfilters to serialize filters using
+ * them.
+ */
+
+template<typename Subfilter>
+struct subfilter_id:std::integral_constant<boost::uint64_t,0>{};
+
+template<typename Block,std::size_t K>
+struct subfilter_id<block<Block,K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(1,sizeof(Block),K)>{};
+
+template<typename Block,std::size_t K>
+struct subfilter_id<multiblock<Block,K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(2,sizeof(Block),K)>{};
+
+template<std::size_t K,std::size_t Bits>
+struct subfilter_id<fast_block<K,Bits>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(3,Bits/CHAR_BIT,K)>{};
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)|| \
+    defined(BOOST_BLOOM_AVX512)||defined(BOOST_BLOOM_AVX2)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(4,sizeof(boost::uint32_t),K)>{};
+
+template<std::size_t K>
+struct subfilter_id<fast_multiblock64<K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(5,sizeof(boost::uint64_t),K)>{};
+#elif defined(BOOST_BLOOM_SSE2)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(6,sizeof(boost::uint32_t),K)>{};
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:std::integral_constant<
+  boost::uint64_t,detail::make_subfilter_id(7,sizeof(boost::uint32_t),K)>{};
+#endif
+
+/* concurrent_filter has the same array as the equivalent filter */
+
+template<typename Subfilter,std::size_t BucketSize>
+struct subfilter_id<detail::atomic_subfilter<Subfilter,BucketSize>>:
+  subfilter_id<Subfilter>{};
+
+namespace detail{
+
+inline void serialization_store(
+  unsigned char* p,boost::uint64_t x,std::size_t n)
+{
+  for(std::size_t i=0;i<n;++i)p[i]=(unsigned char)(x>>(8*i));
+}
+
+inline boost::uint64_t serialization_load(
+  const unsigned char* p,std::size_t n)
+{
+  boost::uint64_t x=0;
+  for(std::size_t i=0;i<n;++i)x|=(boost::uint64_t)p[i]<<(8*i);
+  return x;
+}
+
+/* Header layout (multibyte fields little-endian):
+ *
+ *   [ 0, 8) magic (BOOSTBLM for raw arrays, BOOSTBLZ for compressed ones)
+ *   [ 8,10) format version
+ *   [10,12) trailing padding after the array
+ *   [12,13) endianness of the array (1: little, 2: big)
+ *   [13,14) sizeof(std::size_t) (size of hash values)
+ *   [14,16) flags (bit 0: hash values are mixed, bits 8-15: hash strategy)
+ *   [16,20) k
+ *   [20,24) bucket size
+ *   [24,32) subfilter id
+ *   [32,40) hash id
+ *   [40,44) used value size of the subfilter
+ *   [44,48) type signature: CRC32C of [12,44)
+ *   [48,56) capacity in bits
+ *   [56,60) CRC32C of the array (of the compressed data if compressed)
+ *   [60,64) CRC32C of [0,60)
+ *
+ * The header is followed by the array and trailing padding or, if
+ * compressed, by the size of the compressed data (8 bytes) and the
+ * compressed data itself (see detail/compression.hpp), with no padding.
+ */
+
+/* magic numbers are returned by inline functions so that all translation
+ * units refer to the same arrays
+ */
+
+inline const unsigned char* serialization_magic()noexcept
+{
+  static constexpr unsigned char magic[8]={'B','O','O','S','T','B','L','M'};
+  return magic;
+}
+
+inline const unsigned char* serialization_compressed_magic()noexcept
+{
+  static constexpr unsigned char magic[8]={'B','O','O','S','T','B','L','Z'};
+  return magic;
+}
+
+static constexpr std::size_t   serialization_version=1;
+static constexpr std::size_t   serialization_type_first=12;
+static constexpr std::size_t   serialization_type_last=48;
+
+template<typename Filter>
+struct serialization_traits
+{
+  using subfilter=typename Filter::subfilter;
+  using hasher=typename Filter::hasher;
+  using hash_strategy=typename Filter::hash_strategy;
+  using block_type=typename subfilter::value_type;
+
+  static_assert(
+    subfilter_id<subfilter>::value!=0,
+    "boost::bloom::subfilter_id must be specialized for user-defined "
+    "subfilters with a non-zero value");
+  static_assert(
+    hash_id<hasher>::value!=0,
+    "boost::bloom::hash_id must be specialized for user-defined "
+    "hash functions with a non-zero value");
+  static_assert(
+    hash_strategy_id<hash_strategy>::value<255,
+    "boost::bloom::hash_strategy_id must be specialized for user-defined "
+    "hash strategies with a value in [128,255)");
+
+  static constexpr std::size_t used_value_size=
+    detail::used_value_size<subfilter>::value;
+  static constexpr std::size_t trailing_padding=
+    sizeof(block_type)-used_value_size;
+
+  static constexpr bool mixed=
+    !std::is_same<mix_policy_for<hasher>,no_mix_policy>::value;
+
+  static void store_type(unsigned char* p)
+  {
+#if BOOST_ENDIAN_BIG_BYTE
+    p[12]=2;
+#else
+    p[12]=1;
+#endif
+    p[13]=(unsigned char)sizeof(std::size_t);
+    serialization_store(
+      p+14,(mixed?1:0)|hash_strategy_id<hash_strategy>::value<<8,2);
+    serialization_store(p+16,Filter::k,4);
+    serialization_store(p+20,Filter::bucket_size,4);
+    serialization_store(p+24,subfilter_id<subfilter>::value,8);
+    serialization_store(p+32,hash_id<hasher>::value,8);
+    serialization_store(p+40,used_value_size,4);
+    serialization_store(p+44,crc32c(p+12,32),4);
+  }
+};
+
+/* data is transferred in chunks of this size, small enough that each chunk
+ * is still cached when its CRC is computed
+ */
+
+constexpr std::size_t serialization_chunk_size()noexcept
+{
+  return 1024*1024;
+}
+
+} /* namespace detail */
+
+/* 64-byte header preceding the array of a serialized filter, which is
+ * followed by trailing_padding() zero bytes so that the serialized data
+ * can be used by filter_view directly (e.g. memory-mapped).
+ */
+
+class serialization_header
+{
+public:
+  static constexpr std::size_t size=64;
+
+  unsigned char*       data()noexcept{return data_;}
+  const unsigned char* data()const noexcept{return data_;}
+
+  boost::uint64_t capacity()const noexcept
+  {
+    return detail::serialization_load(data_+48,8);
+  }
+
+  std::size_t trailing_padding()const noexcept
+  {
+    return (std::size_t)detail::serialization_load(data_+10,2);
+  }
+
+  boost::uint32_t checksum()const noexcept
+  {
+    return (boost::uint32_t)detail::serialization_load(data_+56,4);
+  }
+
+  bool compressed()const noexcept
+  {
+    return std::memcmp(
+      data_,detail::serialization_compressed_magic(),8)==0;
+  }
+
+private:
+  unsigned char data_[size];
+};
+
+namespace detail{
+
+/* header for the array s of a Filter */
+
+template<typename Filter>
+serialization_header serialization_make_header(
+  boost::span<const unsigned char> s,bool compressed,boost::uint32_t checksum)
+{
+  using traits=serialization_traits<Filter>;
+
+  serialization_header h;
+  auto                 p=h.data();
+  std::memcpy(
+    p,compressed?serialization_compressed_magic():serialization_magic(),8);
+  serialization_store(p+8,serialization_version,2);
+  serialization_store(p+10,compressed?0:traits::trailing_padding,2);
+  traits::store_type(p);
+  serialization_store(p+48,(boost::uint64_t)s.size()*CHAR_BIT,8);
+  serialization_store(p+56,checksum,4);
+  serialization_store(p+60,crc32c(p,60),4);
+  return h;
+}
+
+} /* namespace detail */
+
+template<typename Filter>
+serialization_header make_serialization_header(const Filter& f)
+{
+  auto s=f.array();
+  return detail::serialization_make_header<Filter>(
+    s,false,detail::crc32c(s.data(),s.size()));
+}
+
+/* checks that h can be loaded into a Filter and returns its capacity */
+
+template<typename Filter>
+std::size_t read_serialization_header(const serialization_header& h)
+{
+  using traits=detail::serialization_traits<Filter>;
+
+  auto p=h.data();
+  if(std::memcmp(p,detail::serialization_magic(),8)!=0&&!h.compressed()){
+    BOOST_THROW_EXCEPTION(
+      std::invalid_argument("not a serialized Bloom filter"));
+  }
+  if(detail::serialization_load(p+60,4)!=detail::crc32c(p,60)){
+    BOOST_THROW_EXCEPTION(std::runtime_error("corrupted header"));
+  }
+  if(detail::serialization_load(p+8,2)!=detail::serialization_version){
+    BOOST_THROW_EXCEPTION(
+      std::invalid_argument("unsupported serialization format version"));
+  }
+
+  unsigned char type[serialization_header::size];
+  traits::store_type(type);
+  if(p[12]!=type[12]){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible endianness"));
+  }
+  if(std::memcmp(
+    p+detail::serialization_type_first,
+    type+detail::serialization_type_first,
+    detail::serialization_type_last-
+    detail::serialization_type_first)!=0){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filter type"));
+  }
+
+  auto m=h.capacity();
+  if(m>(std::numeric_limits<std::size_t>::max)()){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("invalid capacity"));
+  }
+  return (std::size_t)m;
+}
+
+template<typename Filter>
+void verify_checksum(const Filter& f,const serialization_header& h)
+{
+  auto s=f.array();
+  if(detail::crc32c(s.data(),s.size())!=h.checksum()){
+    BOOST_THROW_EXCEPTION(std::runtime_error("checksum mismatch"));
+  }
+}
+
+namespace detail{
+
+/* sizes f for loading m bits */
+
+template<typename Filter>
+void serialization_prepare_load(Filter& f,std::size_t m)
+{
+  f.reset(m);
+  if(f.capacity()!=m){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("invalid capacity"));
+  }
+}
+
+template<bool Merge,typename Filter>
+void serialization_check_capacity(const Filter& f,std::size_t m)
+{
+  if(Merge&&f.capacity()!=m){
+    BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible capacity"));
+  }
+}
+
+/* Array of f folded levels times (see filter_core::fold), stored in buf,
+ * or f.array() if levels==0. Folding is done on the fly so that f needn't
+ * be copied.
+ */
+
+template<typename Filter>
+boost::span<const unsigned char> serialization_fold(
+  const Filter& f,std::size_t levels,std::vector<unsigned char>& buf)
+{
+  using traits=serialization_traits<Filter>;
+  static constexpr std::size_t bucket_size=Filter::bucket_size;
+  static constexpr std::size_t tail=traits::used_value_size-bucket_size;
+
+  boost::span<const unsigned char> s=f.array();
+  if(levels==0||s.size()==0)return s;
+  if(!is_foldable<typename traits::hash_strategy>::value){
+    BOOST_THROW_EXCEPTION(std::invalid_argument(
+      "the hash strategy doesn't support folding"));
+  }
+  std::size_t rng=(s.size()-tail)/bucket_size,
+              folded_rng=folded_range(rng,levels);
+  buf.assign(folded_rng*bucket_size+tail,0);
+  fold_array<bucket_size,traits::used_value_size>(
+    buf.data(),s.data(),rng,levels);
+  return {buf.data(),buf.size()};
+}
+
+template<typename Filter>
+void serialization_append(
+  boost::span<const unsigned char> s,std::vector<unsigned char>& out,
+  serialization_format fmt)
+{
+  static constexpr std::size_t size=serialization_header::size;
+
+  auto first=out.size();
+  if(fmt==serialization_format::raw){
+    auto h=serialization_make_header<Filter>(
+      s,false,crc32c(s.data(),s.size()));
+    out.reserve(first+size+s.size()+h.trailing_padding());
+    out.insert(out.end(),h.data(),h.data()+size);
+    out.insert(out.end(),s.data(),s.data()+s.size());
+    out.resize(out.size()+h.trailing_padding());
+  }
+  else{
+    out.resize(first+size+8);
+    compress_array(s.data(),s.size(),out);
+    auto p=out.data()+first;
+    auto n=out.size()-first-size-8;
+    auto h=serialization_make_header<Filter>(s,true,crc32c(p+size+8,n));
+    std::memcpy(p,h.data(),size);
+    serialization_store(p+size,n,8);
+  }
+}
+
+/* Stores into f, or ORs into f if Merge, the serialized data [p,p+n)
+ * following h: the array (n==m/CHAR_BIT) or the compressed data. Data is
+ * verified before f is modified.
+ */
+
+template<bool Merge,typename Filter>
+void serialization_decode(
+  Filter& f,const serialization_header& h,std::size_t m,
+  const unsigned char* p,std::size_t n)
+{
+  if(crc32c(p,n)!=h.checksum()){
+    BOOST_THROW_EXCEPTION(std::runtime_error("checksum mismatch"));
+  }
+  if(!Merge)serialization_prepare_load(f,m);
+
+  auto s=f.array();
+  if(h.compressed())decompress_array<Merge>(p,p+n,s.data(),s.size());
+  else              decompression_copy<Merge>(s.data(),p,s.size());
+}
+
+template<bool Merge,typename Filter>
+void serialization_load_memory(
+  Filter& f,const unsigned char* p,std::size_t n)
+{
+  static constexpr std::size_t size=serialization_header::size;
+
+  if(n<size){
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of data"));
+  }
+
+  serialization_header h;
+  std::memcpy(h.data(),p,size);
+  auto m=read_serialization_header<Filter>(h);
+  serialization_check_capacity<Merge>(f,m);
+  p+=size;
+  n-=size;
+
+  BOOST_TRY{
+    std::size_t len;
+    if(h.compressed()){
+      if(n<8||serialization_load(p,8)>n-8){
+        BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of data"));
+      }
+      len=(std::size_t)serialization_load(p,8);
+      p+=8;
+    }
+    else{
+      len=m/CHAR_BIT;
+      if(n<len+h.trailing_padding()){
+        BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of data"));
+      }
+    }
+    serialization_decode<Merge>(f,h,m,p,len);
+  }
+  BOOST_CATCH(...){
+    if(!Merge)f.clear();
+    BOOST_RETHROW;
+  }
+  BOOST_CATCH_END
+}
+
+/* Reader(p,n) reads n bytes into p or throws */
+
+template<bool Merge,typename Filter,typename Reader>
+void serialization_load_from(Filter& f,Reader read)
+{
+  serialization_header h;
+  read(h.data(),serialization_header::size);
+  auto m=read_serialization_header<Filter>(h);
+  serialization_check_capacity<Merge>(f,m);
+
+  BOOST_TRY{
+    if(h.compressed()||Merge){
+      /* data is read entirely so that it is verified before being
+       * decoded
+       */
+
+      std::size_t len,data_len;
+      if(h.compressed()){
+        unsigned char buf[8];
+        read(buf,8);
+        auto n=serialization_load(buf,8);
+        if(n>compression_max_size(m/CHAR_BIT)){
+          BOOST_THROW_EXCEPTION(
+            std::runtime_error("invalid compressed data size"));
+        }
+        len=data_len=(std::size_t)n;
+      }
+      else{
+        data_len=m/CHAR_BIT;
+        len=data_len+h.trailing_padding();
+      }
+      std::vector<unsigned char> data(len);
+      read(data.data(),len);
+      serialization_decode<Merge>(f,h,m,data.data(),data_len);
+    }
+    else{
+      serialization_prepare_load(f,m);
+      auto            s=f.array();
+      boost::uint32_t crc=0;
+      for(std::size_t i=0;i<s.size();){
+        auto n=(std::min)(serialization_chunk_size(),s.size()-i);
+        read(s.data()+i,n);
+        crc=crc32c(s.data()+i,n,crc);
+        i+=n;
+      }
+      unsigned char pad[64];
+      for(auto n=h.trailing_padding();n;){
+        auto c=(std::min)(n,sizeof(pad));
+        read(pad,c);
+        n-=c;
+      }
+      if(crc!=h.checksum()){
+        BOOST_THROW_EXCEPTION(std::runtime_error("checksum mismatch"));
+      }
+    }
+  }
+  BOOST_CATCH(...){
+    if(!Merge)f.clear();
+    BOOST_RETHROW;
+  }
+  BOOST_CATCH_END
+}
+
+struct serialization_stream_reader
+{
+  void operator()(unsigned char* p,std::size_t n)const
+  {
+    if(!is.read((char*)p,(std::streamsize)n)){
+      BOOST_THROW_EXCEPTION(std::runtime_error("error reading filter"));
+    }
+  }
+
+  std::istream& is;
+};
+
+} /* namespace detail */
+
+template<typename Filter>
+void save(
+  const Filter& f,std::ostream& os,
+  serialization_format fmt=serialization_format::raw,
+  std::size_t fold_levels=0)
+{
+  static const unsigned char zeros[
+    detail::serialization_traits<Filter>::trailing_padding+1]={};
+
+  std::vector<unsigned char> folded;
+  auto                       s=detail::serialization_fold(
+                               f,fold_levels,folded);
+  if(fmt==serialization_format::compressed){
+    std::vector<unsigned char> buf;
+    detail::serialization_append<Filter>(s,buf,fmt);
+    os.write((const char*)buf.data(),(std::streamsize)buf.size());
+  }
+  else{
+    auto h=detail::serialization_make_header<Filter>(
+      s,false,detail::crc32c(s.data(),s.size()));
+
+    /* the array is written in a call of its own, so that file streams can
+     * bypass their buffer for large writes
+     */
+
+    os.write((const char*)h.data(),serialization_header::size);
+    os.write((const char*)s.data(),(std::streamsize)s.size());
+    os.write((const char*)zeros,(std::streamsize)h.trailing_padding());
+  }
+  if(!os)BOOST_THROW_EXCEPTION(std::runtime_error("error writing filter"));
+}
+
+template<typename Filter>
+void save(
+  const Filter& f,std::vector<unsigned char>& out,
+  serialization_format fmt=serialization_format::raw,
+  std::size_t fold_levels=0)
+{
+  std::vector<unsigned char> folded;
+  detail::serialization_append<Filter>(
+    detail::serialization_fold(f,fold_levels,folded),out,fmt);
+}
+
+template<typename Filter>
+void load(Filter& f,std::istream& is)
+{
+  detail::serialization_load_from<false>(
+    f,detail::serialization_stream_reader{is});
+}
+
+template<typename Filter>
+void load(Filter& f,const unsigned char* p,std::size_t n)
+{
+  detail::serialization_load_memory<false>(f,p,n);
+}
+
+template<typename Filter>
+void merge(Filter& f,std::istream& is)
+{
+  detail::serialization_load_from<true>(
+    f,detail::serialization_stream_reader{is});
+}
+
+template<typename Filter>
+void merge(Filter& f,const unsigned char* p,std::size_t n)
+{
+  detail::serialization_load_memory<true>(f,p,n);
+}
+
+#if defined(BOOST_HAS_UNISTD_H)
+namespace detail{
+
+inline void serialization_throw_errno(const char* what)
+{
+  BOOST_THROW_EXCEPTION(
+    std::system_error(errno,std::generic_category(),what));
+}
+
+/* writes the buffers in [iov,iov+n) entirely, n<=3; the size of each
+ * writev call is capped as some systems reject totals above INT_MAX
+ */
+
+inline void serialization_writev(int fd,::iovec* iov,std::size_t n)
+{
+  static constexpr std::size_t max_size=std::size_t(1)<<30;
+
+  while(n){
+    ::iovec     v[3];
+    std::size_t m=0,total=0;
+    for(;m<n&&total<max_size;++m){
+      v[m]=iov[m];
+      v[m].iov_len=(std::min)(v[m].iov_len,max_size-total);
+      total+=v[m].iov_len;
+    }
+    auto res=::writev(fd,v,(int)m);
+    if(res<0){
+      if(errno==EINTR)continue;
+      serialization_throw_errno("writev");
+    }
+    auto w=(std::size_t)res;
+    for(;n&&w>=iov->iov_len;++iov,--n)w-=iov->iov_len;
+    if(n){
+      iov->iov_base=(unsigned char*)iov->iov_base+w;
+      iov->iov_len-=w;
+    }
+  }
+}
+
+inline void serialization_read(int fd,unsigned char* p,std::size_t n)
+{
+  while(n){
+    auto res=::read(fd,p,n);
+    if(res<0){
+      if(errno==EINTR)continue;
+      serialization_throw_errno("read");
+    }
+    if(res==0){
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of file"));
+    }
+    p+=res;
+    n-=(std::size_t)res;
+  }
+}
+
+struct serialization_fd_reader
+{
+  void operator()(unsigned char* p,std::size_t n)const
+  {
+    serialization_read(fd,p,n);
+  }
+
+  int fd;
+};
+
+} /* namespace detail */
+
+template<typename Filter>
+void save(
+  const Filter& f,int fd,serialization_format fmt=serialization_format::raw,
+  std::size_t fold_levels=0)
+{
+  static const unsigned char zeros[
+    detail::serialization_traits<Filter>::trailing_padding+1]={};
+
+  std::vector<unsigned char> folded;
+  auto                       s=detail::serialization_fold(
+                               f,fold_levels,folded);
+  if(fmt==serialization_format::compressed){
+    std::vector<unsigned char> buf;
+    detail::serialization_append<Filter>(s,buf,fmt);
+    ::iovec iov[1]={{buf.data(),buf.size()}};
+    detail::serialization_writev(fd,iov,1);
+    return;
+  }
+
+  auto    h=detail::serialization_make_header<Filter>(
+    s,false,detail::crc32c(s.data(),s.size()));
+  ::iovec iov[3]={
+    {h.data(),serialization_header::size},
+    {const_cast<unsigned char*>(s.data()),s.size()},
+    {const_cast<unsigned char*>(zeros),h.trailing_padding()}
+  };
+  detail::serialization_writev(fd,iov,3);
+}
+
+template<typename Filter>
+void load(Filter& f,int fd)
+{
+  detail::serialization_load_from<false>(
+    f,detail::serialization_fd_reader{fd});
+}
+
+template<typename Filter>
+void merge(Filter& f,int fd)
+{
+  detail::serialization_load_from<true>(
+    f,detail::serialization_fd_reader{fd});
+}
+#endif
+
+/* creates a filter_view over serialized data in [p,p+n), e.g. a
+ * memory-mapped file; p+serialization_header::size must be suitably
+ * aligned for FilterView
+ */
+
+template<typename FilterView>
+FilterView load_view(
+  const unsigned char* p,std::size_t n,bool verify=true,
+  const typename FilterView::hasher& h=typename FilterView::hasher())
+{
+  if(n<serialization_header::size){
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of data"));
+  }
+
+  serialization_header hd;
+  std::memcpy(hd.data(),p,serialization_header::size);
+  auto m=read_serialization_header<FilterView>(hd);
+  if(hd.compressed()){
+    BOOST_THROW_EXCEPTION(
+      std::invalid_argument("compressed data can't be viewed"));
+  }
+  if(n-serialization_header::size<
+     m/CHAR_BIT+FilterView::trailing_padding){
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of data"));
+  }
+
+  FilterView fv(p+serialization_header::size,m,h);
+  if(verify)verify_checksum(fv,hd);
+  return fv;
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
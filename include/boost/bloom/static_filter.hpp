@@ -0,0 +1,277 @@
+/* Immutable binary fuse filter for static sets.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_STATIC_FILTER_HPP
+#define BOOST_BLOOM_STATIC_FILTER_HPP
+
+#include <boost/bloom/detail/fuse_core.hpp>
+#include <boost/bloom/detail/parallel.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* static_filter is built once from the whole set of elements and can't be
+ * modified afterwards. Elements are hashed as in filter (same Hash and
+ * mixing policy), and the resulting values fed to a binary fuse filter
+ * with FingerprintBits-bit fingerprints (see
+ * <boost/bloom/detail/fuse_core.hpp>).
+ */
+
+template<
+  typename T,std::size_t FingerprintBits=8,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<T>
+>
+class
+
+#if defined(_MSC_VER)&&_MSC_FULL_VER>=190023918
+__declspec(empty_bases) /* activate EBO with multiple inheritance */
+#endif
+
+static_filter:
+  detail::fuse_core<
+    FingerprintBits,allocator_rebind_t<Allocator,unsigned char>>,
+  empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<T,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be T");
+  using super=detail::fuse_core<
+    FingerprintBits,allocator_rebind_t<Allocator,unsigned char>>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+public:
+  using value_type=T;
+  using super::fingerprint_bits;
+  using fingerprint_type=typename super::fingerprint_type;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+
+  static_filter()=default;
+
+  explicit static_filter(
+    const hasher& h,const allocator_type& al=allocator_type()):
+    super{al},hash_base{empty_init,h}{}
+
+  explicit static_filter(const allocator_type& al):
+    static_filter{hasher(),al}{}
+
+  template<typename InputIterator>
+  static_filter(
+    InputIterator first,InputIterator last,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    static_filter{h,al}
+  {
+    super::build_sequential([&,this](boost::uint64_t& hash)->bool{
+      if(first==last)return false;
+      hash=hash_for(*first);
+      ++first;
+      return true;
+    });
+  }
+
+  template<
+    typename Executor,typename RandomAccessIterator,
+    detail::enable_if_executor_t<Executor>* =nullptr
+  >
+  static_filter(
+    Executor&& ex,RandomAccessIterator first,RandomAccessIterator last,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    static_filter{h,al}
+  {
+    static_assert(
+      std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category
+      >::value,
+      "parallel construction requires random-access iterators");
+
+    auto&& pex=detail::make_executor(ex);
+    super::build(
+      (std::size_t)(last-first),
+      [&,this](std::size_t i){return hash_for(first[i]);},
+      pex);
+  }
+
+  static_filter(
+    std::initializer_list<value_type> il,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    static_filter{il.begin(),il.end(),h,al}{}
+
+  template<typename InputIterator>
+  static_filter(
+    InputIterator first,InputIterator last,const allocator_type& al):
+    static_filter{first,last,hasher(),al}{}
+
+  static_filter(
+    std::initializer_list<value_type> il,const allocator_type& al):
+    static_filter{il,hasher(),al}{}
+
+  static_filter(const static_filter&)=default;
+  static_filter(static_filter&&)=default;
+
+  static_filter& operator=(const static_filter& x)
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    auto x_h=x.h();
+    super::operator=(x);
+    swap(h(),x_h);
+    return *this;
+  }
+
+  static_filter& operator=(static_filter&& x)
+    noexcept(noexcept(std::declval<super&>()=(std::declval<super&&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    super::operator=(std::move(x));
+    swap(h(),x.h());
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return allocator_type(super::get_allocator());
+  }
+
+  using super::capacity;
+  using super::fpr;
+
+  void swap(static_filter& x)
+    noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    super::swap(x);
+    swap(h(),x.h());
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return super::may_contain(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return super::may_contain(hash_for(x));
+  }
+
+  template<typename InputIterator,typename OutputIterator>
+  OutputIterator may_contain(
+    InputIterator first,InputIterator last,OutputIterator res)const
+  {
+    static constexpr std::size_t N=super::bulk_lookup_size;
+
+    boost::uint64_t hashes[N];
+    bool            results[N];
+    while(first!=last){
+      std::size_t n=0;
+      do{
+        hashes[n++]=hash_for(*first);
+        ++first;
+      }while(n<N&&first!=last);
+      super::bulk_may_contain(hashes,n,results);
+      res=std::copy(results,results+n,res);
+    }
+    return res;
+  }
+
+private:
+  template<typename T1,std::size_t F1,typename H,typename A>
+  bool friend operator==(
+    const static_filter<T1,F1,H,A>& x,const static_filter<T1,F1,H,A>& y);
+
+  using hash_base=empty_value<Hash,0>;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE boost::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+};
+
+template<typename T,std::size_t F,typename H,typename A>
+bool operator==(
+  const static_filter<T,F,H,A>& x,const static_filter<T,F,H,A>& y)
+{
+  using super=typename static_filter<T,F,H,A>::super;
+  return static_cast<const super&>(x)==static_cast<const super&>(y);
+}
+
+template<typename T,std::size_t F,typename H,typename A>
+bool operator!=(
+  const static_filter<T,F,H,A>& x,const static_filter<T,F,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,std::size_t F,typename H,typename A>
+void swap(static_filter<T,F,H,A>& x,static_filter<T,F,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,151 @@
+/* Thread pool for parallel filter operations.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_THREAD_EXECUTOR_HPP
+#define BOOST_BLOOM_THREAD_EXECUTOR_HPP
+
+#include <boost/core/no_exceptions_support.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+
+/* ex(n,f) invokes f(i) for i in [0,n) on the calling thread plus
+ * num_threads()-1 pooled worker threads, which grab indices dynamically for
+ * load balancing, and returns when all invocations are done. If some
+ * invocation throws, remaining indices are skipped and the first exception
+ * is rethrown in the calling thread. Calls from different threads are
+ * serialized.
+ */
+
+class thread_executor
+{
+public:
+  thread_executor():
+    thread_executor{(std::max)(std::thread::hardware_concurrency(),1u)}{}
+
+  explicit thread_executor(std::size_t num_threads)
+  {
+    if(num_threads==0)num_threads=1;
+    BOOST_TRY{
+      for(std::size_t i=1;i<num_threads;++i){
+        workers.emplace_back([this]{worker_loop();});
+      }
+    }
+    BOOST_CATCH(...){
+      stop_workers();
+      BOOST_RETHROW;
+    }
+    BOOST_CATCH_END
+  }
+
+  thread_executor(const thread_executor&)=delete;
+  thread_executor& operator=(const thread_executor&)=delete;
+
+  ~thread_executor(){stop_workers();}
+
+  std::size_t num_threads()const noexcept{return workers.size()+1;}
+
+  template<typename F>
+  void operator()(std::size_t n,F f)
+  {
+    std::lock_guard<std::mutex> call_lck{call_mutex};
+    {
+      std::lock_guard<std::mutex> lck{mutex};
+      job_fn=&invoke<F>;
+      job_arg=&f;
+      job_size=n;
+      next=0;
+      num_busy=workers.size();
+      job_exception=nullptr;
+      ++generation;
+    }
+    work_available.notify_all();
+    run_job();
+    std::unique_lock<std::mutex> lck{mutex};
+    job_done.wait(lck,[this]{return num_busy==0;});
+    if(job_exception)std::rethrow_exception(job_exception);
+  }
+
+private:
+  template<typename F>
+  static void invoke(void* f,std::size_t i){(*static_cast<F*>(f))(i);}
+
+  void run_job()
+  {
+    for(std::size_t i;(i=next.fetch_add(1))<job_size;){
+      BOOST_TRY{
+        job_fn(job_arg,i);
+      }
+      BOOST_CATCH(...){
+        std::lock_guard<std::mutex> lck{mutex};
+        if(!job_exception)job_exception=std::current_exception();
+        next=job_size;
+      }
+      BOOST_CATCH_END
+    }
+  }
+
+  void worker_loop()
+  {
+    std::size_t last_generation=0;
+    for(;;){
+      {
+        std::unique_lock<std::mutex> lck{mutex};
+        work_available.wait(lck,[&,this]{
+          return stop||generation!=last_generation;
+        });
+        if(stop)return;
+        last_generation=generation;
+      }
+      run_job();
+      {
+        std::lock_guard<std::mutex> lck{mutex};
+        if(--num_busy==0)job_done.notify_one();
+      }
+    }
+  }
+
+  void stop_workers()noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lck{mutex};
+      stop=true;
+    }
+    work_available.notify_all();
+    for(auto& th:workers)th.join();
+    workers.clear();
+  }
+
+  std::vector<std::thread> workers;
+  std::mutex               call_mutex;
+  std::mutex               mutex;
+  std::condition_variable  work_available;
+  std::condition_variable  job_done;
+  bool                     stop=false;
+  std::size_t              generation=0;
+  void                   (*job_fn)(void*,std::size_t)=nullptr;
+  void*                    job_arg=nullptr;
+  std::size_t              job_size=0;
+  std::atomic<std::size_t> next{0};
+  std::size_t              num_busy=0;
+  std::exception_ptr       job_exception;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
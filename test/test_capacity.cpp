@@ -68,7 +68,7 @@ void test_capacity()
   {
     BOOST_TEST_THROWS(
       (void)filter((std::numeric_limits<std::size_t>::max)()),
-      std::bad_alloc);
+      capacity_error<filter>);
   }
   {
     filter      f{{fac(),fac()},1000};
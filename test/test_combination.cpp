@@ -8,6 +8,8 @@
 
 #include <boost/core/lightweight_test.hpp>
 #include <boost/mp11/algorithm.hpp>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include "test_types.hpp"
 #include "test_utilities.hpp"
@@ -96,6 +98,139 @@ void test_combination()
     BOOST_TEST(may_contain(f1,input1));
     BOOST_TEST(may_contain(f1,input2));
   }
+  {
+    filter f1{input1.begin(),input1.end(),1000},
+           f1_copy{f1},
+           empty{f1.capacity()};
+
+    BOOST_TEST_THROWS(f1^=filter{},std::invalid_argument);
+    BOOST_TEST_THROWS(f1-=filter{},std::invalid_argument);
+    BOOST_TEST(f1==f1_copy);
+
+    filter& rf1=(f1^=empty);
+    BOOST_TEST_EQ(&rf1,&f1);
+    BOOST_TEST(f1==f1_copy);
+    filter& rf2=(f1-=empty);
+    BOOST_TEST_EQ(&rf2,&f1);
+    BOOST_TEST(f1==f1_copy);
+    f1^=f1_copy;
+    BOOST_TEST(f1==empty);
+    f1=f1_copy;
+    f1-=f1_copy;
+    BOOST_TEST(f1==empty);
+  }
+  {
+    filter       f1{input1.begin(),input1.end(),1000};
+    const filter f2{input2.begin(),input2.end(),f1.capacity()};
+    filter       f3{f1};
+
+    f3|=f2;
+    BOOST_TEST(f1.is_subset_of(f1));
+    BOOST_TEST(f1.is_subset_of(f3));
+    BOOST_TEST(f2.is_subset_of(f3));
+    BOOST_TEST(!f3.is_subset_of(f1));
+    BOOST_TEST(filter{f1.capacity()}.is_subset_of(f1));
+    BOOST_TEST(!f1.is_subset_of(filter{}));
+    BOOST_TEST(filter{}.is_subset_of(filter{}));
+  }
+  {
+    /* results are checked against bytewise operations */
+
+    std::vector<filter> fs;
+    for(int i=0;i<5;++i){
+      std::vector<value_type> input;
+      for(int j=0;j<1000;++j)input.push_back(fac());
+      fs.emplace_back(input.begin(),input.end(),100000);
+    }
+    auto bytewise=[&](const filter& x,const filter& y,int op){
+      std::vector<unsigned char> res(x.array().begin(),x.array().end());
+      auto                       ay=y.array();
+      for(std::size_t i=0;i<res.size();++i){
+        switch(op){
+          case 0: res[i]&=ay[i];break;
+          case 1: res[i]|=ay[i];break;
+          case 2: res[i]^=ay[i];break;
+          default: res[i]&=(unsigned char)~ay[i];
+        }
+      }
+      return res;
+    };
+    auto bytes=[](const filter& x){
+      return std::vector<unsigned char>(x.array().begin(),x.array().end());
+    };
+
+    filter f{fs[0]};
+    f&=fs[1];
+    BOOST_TEST(bytes(f)==bytewise(fs[0],fs[1],0));
+    f=fs[0];
+    f|=fs[1];
+    BOOST_TEST(bytes(f)==bytewise(fs[0],fs[1],1));
+    f=fs[0];
+    f^=fs[1];
+    BOOST_TEST(bytes(f)==bytewise(fs[0],fs[1],2));
+    f=fs[0];
+    f-=fs[1];
+    BOOST_TEST(bytes(f)==bytewise(fs[0],fs[1],3));
+
+    filter f_union{fs[0].capacity()},
+           f_inter{fs[0]},
+           expected_union{fs[0].capacity()},
+           expected_inter{fs[0]};
+    for(const auto& x:fs){
+      expected_union|=x;
+      expected_inter&=x;
+    }
+    filter& rf1=f_union.union_with(fs.begin(),fs.end());
+    BOOST_TEST_EQ(&rf1,&f_union);
+    BOOST_TEST(f_union==expected_union);
+    filter& rf2=f_inter.intersection_with(fs.begin(),fs.end());
+    BOOST_TEST_EQ(&rf2,&f_inter);
+    BOOST_TEST(f_inter==expected_inter);
+    for(const auto& x:fs){
+      BOOST_TEST(x.is_subset_of(f_union));
+      BOOST_TEST(f_inter.is_subset_of(x));
+    }
+
+    f=fs[0];
+    f.union_with(fs.end(),fs.end());
+    BOOST_TEST(f==fs[0]);
+    fs.push_back(filter{});
+    BOOST_TEST_THROWS(
+      f.union_with(fs.begin(),fs.end()),std::invalid_argument);
+    BOOST_TEST(f==fs[0]);
+    BOOST_TEST_THROWS(
+      f.intersection_with(fs.begin(),fs.end()),std::invalid_argument);
+    BOOST_TEST(f==fs[0]);
+  }
+  if(!std::numeric_limits<value_type>::is_specialized||
+     std::numeric_limits<value_type>::digits>=12){ /* 3000 distinct values */
+    std::vector<value_type> input;
+    for(int i=0;i<3000;++i)input.push_back(fac());
+
+    /* f1 and f2 share 1000 out of 2000 elements each */
+
+    filter f1{input.begin(),input.begin()+2000,60000},
+           f2{input.begin()+1000,input.end(),f1.capacity()},
+           empty{f1.capacity()};
+
+    BOOST_TEST_LE(std::abs(f1.estimated_intersection_size(f2)-1000),100);
+    BOOST_TEST_LE(std::abs(f1.estimated_union_size(f2)-3000),300);
+    BOOST_TEST_LE(std::abs(f1.jaccard_index(f2)-1.0/3),0.05);
+    BOOST_TEST_EQ(
+      f1.estimated_intersection_size(f2),f2.estimated_intersection_size(f1));
+    BOOST_TEST_EQ(f1.estimated_union_size(f1),f1.estimated_size());
+    BOOST_TEST_EQ(f1.jaccard_index(f1),1.0);
+    BOOST_TEST_EQ(f1.estimated_intersection_size(empty),0.0);
+    BOOST_TEST_EQ(f1.jaccard_index(empty),0.0);
+    BOOST_TEST_EQ(empty.jaccard_index(empty),1.0);
+    BOOST_TEST_EQ(filter{}.estimated_union_size(filter{}),0.0);
+
+    BOOST_TEST_THROWS(
+      (void)f1.estimated_intersection_size(filter{}),std::invalid_argument);
+    BOOST_TEST_THROWS(
+      (void)f1.estimated_union_size(filter{}),std::invalid_argument);
+    BOOST_TEST_THROWS((void)f1.jaccard_index(filter{}),std::invalid_argument);
+  }
 }
 
 struct lambda
@@ -0,0 +1,113 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct concurrent_filter_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
+>
+struct concurrent_filter_for_impl<boost::bloom::filter<T,K,S,B,H,A,HS>>
+{
+  using type=boost::bloom::concurrent_filter<T,K,S,B,H,A,HS>;
+};
+
+template<typename Filter>
+using concurrent_filter_for=typename concurrent_filter_for_impl<Filter>::type;
+
+template<typename Filter,typename ValueFactory>
+void test_concurrent()
+{
+  using filter=Filter;
+  using concurrent_filter=concurrent_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  static constexpr std::size_t num_threads=4,
+                               num_elements=20000;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,preinput;
+  for(std::size_t i=0;i<num_elements;++i)input.push_back(fac());
+  for(std::size_t i=0;i<100;++i)preinput.push_back(fac());
+
+  {
+    concurrent_filter f1(num_elements*10);
+    filter            f2(f1.capacity());
+    BOOST_TEST_EQ(f1.capacity(),f2.capacity());
+
+    f1.insert(preinput.begin(),preinput.end());
+    f2.insert(preinput.begin(),preinput.end());
+    f2.insert(input.begin(),input.end());
+
+    /* writers insert input (half of them element by element, the other
+     * half in bulk) while readers check that preinput is always found
+     */
+
+    std::atomic<std::size_t> num_writers{num_threads};
+    std::atomic<bool>        readers_ok{true};
+    std::vector<std::thread> threads;
+    for(std::size_t t=0;t<num_threads;++t){
+      threads.emplace_back([&,t]{
+        auto first=input.begin()+t*num_elements/num_threads,
+             last=input.begin()+(t+1)*num_elements/num_threads;
+        if(t%2)f1.insert(first,last);
+        else for(;first!=last;++first)f1.insert(*first);
+        --num_writers;
+      });
+      threads.emplace_back([&]{
+        do{
+          if(!may_contain(f1,preinput))readers_ok=false;
+        }while(num_writers);
+      });
+    }
+    for(auto& th:threads)th.join();
+
+    BOOST_TEST(readers_ok);
+    BOOST_TEST(may_contain(f1,input));
+    BOOST_TEST_EQ(f1.array().size(),f2.array().size());
+    BOOST_TEST(std::memcmp(
+      f1.array().data(),f2.array().data(),f1.array().size())==0);
+  }
+  {
+    concurrent_filter f(0);
+    f.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(f.capacity(),0u);
+    BOOST_TEST(may_contain(f,input));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_concurrent<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,166 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/counting_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,std::size_t CounterBits>
+struct counting_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS,std::size_t CounterBits
+>
+struct counting_for_impl<boost::bloom::filter<T,K,S,B,H,A,HS>,CounterBits>
+{
+  using type=boost::bloom::counting_filter<T,K,S,B,CounterBits,H,A,HS>;
+};
+
+template<typename Filter,std::size_t CounterBits>
+using counting_for=typename counting_for_impl<Filter,CounterBits>::type;
+
+template<typename CountingFilter>
+void test_counting_filter()
+{
+  using counting_filter=CountingFilter;
+  using filter=typename counting_filter::filter_type;
+  using value_type=typename filter::value_type;
+
+  std::vector<value_type> input;
+  value_factory<value_type> fac;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  auto mid=input.begin()+500;
+
+  {
+    counting_filter cf;
+    BOOST_TEST_EQ(cf.capacity(),0u);
+    BOOST_TEST(cf.may_contain(input[0]));
+    cf.insert(input[0]);
+    BOOST_TEST(!cf.erase(input[0]));
+    BOOST_TEST(cf.to_filter()==filter());
+  }
+  {
+    counting_filter cf(100000);
+    BOOST_TEST_EQ(cf.capacity(),filter(100000).capacity());
+    BOOST_TEST_EQ(
+      counting_filter(1000,0.01).capacity(),filter(1000,0.01).capacity());
+    BOOST_TEST_EQ(
+      counting_filter::capacity_for(1000,0.01),
+      filter::capacity_for(1000,0.01));
+    BOOST_TEST(may_not_contain(cf,input));
+    BOOST_TEST(cf.to_filter()==filter(100000));
+
+    /* same array as the plain filter */
+
+    cf.insert(input.begin(),input.end());
+    filter f(100000);
+    f.insert(input.begin(),input.end());
+    BOOST_TEST(may_contain(cf,input));
+    BOOST_TEST(cf.to_filter()==f);
+    for(const auto& x:input){
+      if(cf.may_contain(x)!=f.may_contain(x)){
+        BOOST_ERROR("lookup mismatch");
+        break;
+      }
+    }
+
+    /* erasure leaves the array of the remaining elements */
+
+    for(auto it=input.begin();it!=mid;++it)BOOST_TEST(cf.erase(*it));
+    filter f2(100000);
+    f2.insert(mid,input.end());
+    BOOST_TEST(may_contain(cf,std::vector<value_type>(mid,input.end())));
+    BOOST_TEST(cf.to_filter()==f2);
+
+    for(auto it=mid;it!=input.end();++it)BOOST_TEST(cf.erase(*it));
+    BOOST_TEST(cf==counting_filter(100000));
+
+    /* copy, move, swap */
+
+    cf.insert(input.begin(),mid);
+    counting_filter cf2(cf);
+    BOOST_TEST(cf2==cf);
+    counting_filter cf3(std::move(cf2));
+    BOOST_TEST(cf3==cf);
+    BOOST_TEST_EQ(cf2.capacity(),0u);
+    cf2=cf3;
+    BOOST_TEST(cf2==cf);
+    counting_filter cf4(1000);
+    swap(cf4,cf2);
+    BOOST_TEST(cf4==cf);
+    BOOST_TEST_EQ(cf2.capacity(),counting_filter(1000).capacity());
+    cf2=std::move(cf4);
+    BOOST_TEST(cf2==cf);
+    BOOST_TEST(cf4!=cf);
+
+    cf.clear();
+    BOOST_TEST(cf==counting_filter(100000));
+    BOOST_TEST(cf!=cf2);
+  }
+  {
+    /* erasing an element known not to be present changes nothing */
+
+    counting_filter cf(100000);
+    cf.insert(input.begin(),mid);
+    counting_filter cf2(cf);
+    for(auto it=mid;it!=input.end();++it){
+      if(!cf.may_contain(*it))BOOST_TEST(!cf.erase(*it));
+    }
+    BOOST_TEST(cf==cf2);
+  }
+}
+
+template<typename CountingFilter>
+void test_saturation()
+{
+  using counting_filter=CountingFilter;
+  static constexpr int max_count=(1<<counting_filter::counter_bits)-1;
+
+  counting_filter cf(10000);
+  for(int i=0;i<max_count-1;++i)cf.insert(1);
+  for(int i=0;i<max_count-1;++i)BOOST_TEST(cf.erase(1));
+  BOOST_TEST(!cf.may_contain(1));
+  BOOST_TEST(!cf.erase(1));
+
+  /* saturated counters stick */
+
+  for(int i=0;i<max_count+10;++i)cf.insert(1);
+  for(int i=0;i<max_count+20;++i)BOOST_TEST(cf.erase(1));
+  BOOST_TEST(cf.may_contain(1));
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+
+    test_counting_filter<counting_for<filter,4>>();
+    test_counting_filter<counting_for<filter,8>>();
+  }
+};
+
+int main()
+{
+  using namespace boost::bloom;
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  test_saturation<counting_filter<int,3>>();
+  test_saturation<counting_filter<int,1,block<boost::uint64_t,5>,0,8>>();
+  test_saturation<counting_filter<int,2,multiblock<boost::uint32_t,8>,0,4>>();
+  return boost::report_errors();
+}
@@ -0,0 +1,107 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/fast_block.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/* Reference model of the bit selection of fast_block<K,Bits>, which all
+ * implementations (SIMD or not) must reproduce exactly: as in
+ * block<Block,K> with a Bits-wide Block, positions are taken from
+ * consecutive log2(Bits)-bit portions of the hash value, which is mixed
+ * when fewer than log2(Bits) bits remain.
+ */
+
+std::vector<boost::uint64_t> reference_mark(
+  std::size_t k,std::size_t bits,const std::vector<boost::uint64_t>& hashes)
+{
+  const int shift=bits==256?8:9,
+            rehash_k=(64-shift)/shift;
+
+  std::vector<boost::uint64_t> res(bits/64,0);
+  for(auto hash:hashes){
+    auto h=hash;
+    for(std::size_t i=0;i<k;++i){
+      if(i&&i%rehash_k==0){
+        hash=boost::bloom::detail::mulx64(hash);
+        h=hash;
+      }
+      h>>=shift;
+      auto n=h&(bits-1);
+      res[n/64]|=boost::uint64_t(1)<<(n%64);
+    }
+  }
+  return res;
+}
+
+template<typename Subfilter>
+void test_fast_block()
+{
+  using subfilter=Subfilter;
+  using value_type=typename subfilter::value_type;
+
+  static constexpr std::size_t bits=sizeof(value_type)*CHAR_BIT;
+
+  std::mt19937_64 gen(92843);
+
+  for(std::size_t n:{1,2,10}){
+    std::vector<boost::uint64_t> hashes;
+    for(std::size_t i=0;i<n;++i)hashes.push_back(gen());
+
+    value_type x;
+    std::memset(&x,0,sizeof(x));
+    for(auto hash:hashes)subfilter::mark(x,hash);
+    for(auto hash:hashes)BOOST_TEST(subfilter::check(x,hash));
+
+    auto expected=reference_mark(subfilter::k,bits,hashes);
+    BOOST_TEST(std::memcmp(&x,expected.data(),sizeof(x))==0);
+
+    for(int i=0;i<100;++i){
+      auto hash=gen();
+      auto y=reference_mark(subfilter::k,bits,{hash});
+      bool res=true;
+      for(std::size_t j=0;j<y.size();++j){
+        if((expected[j]&y[j])!=y[j])res=false;
+      }
+      BOOST_TEST_EQ(subfilter::check(x,hash),res);
+    }
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::fast_block<1>,
+  boost::bloom::fast_block<5>,
+  boost::bloom::fast_block<7>,
+  boost::bloom::fast_block<8>,
+  boost::bloom::fast_block<15>,
+  boost::bloom::fast_block<1,512>,
+  boost::bloom::fast_block<6,512>,
+  boost::bloom::fast_block<7,512>,
+  boost::bloom::fast_block<12,512>
+>;
+
+struct lambda
+{
+  template<typename Subfilter>
+  void operator()(Subfilter)
+  {
+    test_fast_block<Subfilter>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,173 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/runtime_dispatch.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/* Reference model of the bit selection of the AVX2 implementations, which
+ * the AVX-512 implementations must reproduce exactly: the i-th word of a
+ * group of eight takes a Bits-bit portion of the (mixed) hash value, the
+ * bits of the low 32-bit half of the hash for even i, those of the high
+ * half for odd i.
+ */
+
+template<typename Word,int Bits>
+std::vector<Word> reference_mark(
+  std::size_t k,const std::vector<boost::uint64_t>& hashes)
+{
+  std::vector<Word> res(k,0);
+  for(auto hash:hashes){
+    for(std::size_t i=0;i<k;++i){
+      if(i&&i%8==0)hash=boost::bloom::detail::mulx64(hash);
+      int q=(int)(i%8)/2,
+          shift=(i%2?64:32)-Bits*(q+1);
+      res[i]|=Word(1)<<((hash>>shift)&((1u<<Bits)-1));
+    }
+  }
+  return res;
+}
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+using boost::bloom::detail::simd_level;
+
+template<typename Subfilter>
+void mark_with(
+  simd_level level,typename Subfilter::value_type& x,boost::uint64_t hash)
+{
+  switch(level){
+    case simd_level::avx512: Subfilter::mark_avx512(x,hash);break;
+    case simd_level::avx2:   Subfilter::mark_avx2(x,hash);break;
+    default:                 Subfilter::mark_generic(x,hash);
+  }
+}
+
+template<typename Subfilter>
+bool check_with(
+  simd_level level,const typename Subfilter::value_type& x,
+  boost::uint64_t hash)
+{
+  switch(level){
+    case simd_level::avx512: return Subfilter::check_avx512(x,hash);
+    case simd_level::avx2:   return Subfilter::check_avx2(x,hash);
+    default:                 return Subfilter::check_generic(x,hash);
+  }
+}
+#endif
+
+template<typename Subfilter,typename Word,int Bits>
+void test_fast_multiblock()
+{
+  using subfilter=Subfilter;
+  using value_type=typename subfilter::value_type;
+
+  static constexpr std::size_t used_value_size=
+    boost::bloom::detail::used_value_size<subfilter>::value;
+
+  std::mt19937_64 gen(92843);
+
+  for(std::size_t n:{1,2,10}){
+    std::vector<boost::uint64_t> hashes;
+    for(std::size_t i=0;i<n;++i)hashes.push_back(gen());
+
+    value_type x;
+    std::memset(&x,0,sizeof(x));
+    for(auto hash:hashes)subfilter::mark(x,hash);
+    for(auto hash:hashes)BOOST_TEST(subfilter::check(x,hash));
+
+    unsigned char zeros[sizeof(value_type)]={0};
+    BOOST_TEST(
+      std::memcmp(
+        reinterpret_cast<unsigned char*>(&x)+used_value_size,
+        zeros,sizeof(value_type)-used_value_size)==0);
+
+#if defined(BOOST_BLOOM_AVX2)||defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+    auto expected=reference_mark<Word,Bits>(subfilter::k,hashes);
+    BOOST_TEST(
+      std::memcmp(&x,expected.data(),used_value_size)==0);
+
+    for(int i=0;i<100;++i){
+      auto hash=gen();
+      auto y=reference_mark<Word,Bits>(subfilter::k,{hash});
+      bool res=true;
+      for(std::size_t j=0;j<subfilter::k;++j){
+        if((expected[j]&y[j])!=y[j])res=false;
+      }
+      BOOST_TEST_EQ(subfilter::check(x,hash),res);
+    }
+#endif
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+    /* all the kernels supported by the host produce the same array */
+
+    auto max_level=boost::bloom::detail::runtime_simd_level();
+    for(auto level:{simd_level::generic,simd_level::avx2,simd_level::avx512}){
+      if(level>max_level)break;
+
+      value_type y;
+      std::memset(&y,0,sizeof(y));
+      for(auto hash:hashes)mark_with<subfilter>(level,y,hash);
+      BOOST_TEST(std::memcmp(&x,&y,sizeof(x))==0);
+      for(int i=0;i<100;++i){
+        auto hash=gen();
+        BOOST_TEST_EQ(
+          check_with<subfilter>(level,x,hash),subfilter::check(x,hash));
+      }
+    }
+#endif
+  }
+}
+
+template<std::size_t K>
+using fast_multiblock32_test_type=boost::mp11::mp_list<
+  boost::bloom::fast_multiblock32<K>,boost::uint32_t,boost::mp11::mp_int<5>
+>;
+
+template<std::size_t K>
+using fast_multiblock64_test_type=boost::mp11::mp_list<
+  boost::bloom::fast_multiblock64<K>,boost::uint64_t,boost::mp11::mp_int<6>
+>;
+
+using test_types=boost::mp11::mp_list<
+  fast_multiblock32_test_type<1>,
+  fast_multiblock32_test_type<5>,
+  fast_multiblock32_test_type<8>,
+  fast_multiblock32_test_type<11>,
+  fast_multiblock32_test_type<16>,
+  fast_multiblock32_test_type<23>,
+  fast_multiblock32_test_type<32>,
+  fast_multiblock64_test_type<1>,
+  fast_multiblock64_test_type<4>,
+  fast_multiblock64_test_type<7>,
+  fast_multiblock64_test_type<8>,
+  fast_multiblock64_test_type<13>
+>;
+
+struct lambda
+{
+  template<typename Subfilter,typename Word,typename Bits>
+  void operator()(boost::mp11::mp_list<Subfilter,Word,Bits>)
+  {
+    test_fast_multiblock<Subfilter,Word,Bits::value>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,177 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter_view.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct filter_view_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
+>
+struct filter_view_for_impl<boost::bloom::filter<T,K,S,B,H,A,HS>>
+{
+  using type=boost::bloom::filter_view<T,K,S,B,H,HS>;
+};
+
+template<typename Filter>
+using filter_view_for=typename filter_view_for_impl<Filter>::type;
+
+/* external buffer with the array of f copied at a 64-byte aligned
+ * position and followed by trailing_padding bytes
+ */
+
+template<typename FilterView,typename Filter>
+struct external_buffer
+{
+  external_buffer(const Filter& f):
+    buf(f.array().size()+FilterView::trailing_padding+64)
+  {
+    auto s=f.array();
+    if(s.size())std::memcpy(data(),s.data(),s.size());
+  }
+
+  const unsigned char* data()const
+  {
+    auto p=buf.data();
+    return p+(64-boost::uintptr_t(p)%64)%64;
+  }
+
+  unsigned char* data()
+  {
+    return const_cast<unsigned char*>(
+      static_cast<const external_buffer*>(this)->data());
+  }
+
+  std::vector<unsigned char> buf;
+};
+
+template<typename Filter,typename ValueFactory>
+void test_filter_view()
+{
+  using filter=Filter;
+  using filter_view=filter_view_for<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,others;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  for(int i=0;i<1000;++i)others.push_back(fac());
+
+  for(std::size_t m:{0,1000,100000}){
+    filter f(m);
+    f.insert(input.begin(),input.end());
+
+    external_buffer<filter_view,filter> eb(f);
+    filter_view                         fv(eb.data(),f.capacity());
+    BOOST_TEST_EQ(fv.capacity(),f.capacity());
+    BOOST_TEST_EQ(fv.array().size(),f.array().size());
+    BOOST_TEST(m==0||fv.array().data()==eb.data());
+    BOOST_TEST_EQ(fv.fill_ratio(),f.fill_ratio());
+    BOOST_TEST_EQ(fv.estimated_size(),f.estimated_size());
+    BOOST_TEST(may_contain(fv,input));
+
+    for(const auto& x:others){
+      BOOST_TEST_EQ(fv.may_contain(x),f.may_contain(x));
+      BOOST_TEST_EQ(
+        fv.may_contain_hash(fv.hash_for(x)),f.may_contain(x));
+    }
+
+    std::vector<char> res1(others.size()),res2(others.size());
+    fv.may_contain(others.begin(),others.end(),res1.begin());
+    f.may_contain(others.begin(),others.end(),res2.begin());
+    BOOST_TEST(res1==res2);
+
+    std::vector<boost::uint32_t> sel1(others.size()),sel2(others.size());
+    BOOST_TEST_EQ(
+      fv.may_contain_selection(others,sel1),
+      f.may_contain_selection(others,sel2));
+    BOOST_TEST(sel1==sel2);
+
+    std::vector<boost::uint64_t> bm1((others.size()+63)/64),
+                                 bm2((others.size()+63)/64);
+    fv.may_contain_bitmap(others,bm1);
+    f.may_contain_bitmap(others,bm2);
+    BOOST_TEST(bm1==bm2);
+
+    /* copies share the array */
+
+    filter_view fv2(fv);
+    BOOST_TEST(fv2.array().data()==fv.array().data());
+    BOOST_TEST(may_contain(fv2,input));
+    fv2=filter_view{};
+    BOOST_TEST_EQ(fv2.capacity(),0u);
+    BOOST_TEST(may_contain(fv2,others));
+    fv2=fv;
+    BOOST_TEST(fv2.array().data()==fv.array().data());
+
+    /* view over the array of f itself */
+
+    filter_view fv3(f);
+    BOOST_TEST(fv3.array().data()==f.array().data());
+    BOOST_TEST(may_contain(fv3,input));
+  }
+  {
+    filter_view fv;
+    BOOST_TEST_EQ(fv.capacity(),0u);
+    BOOST_TEST(may_contain(fv,input));
+  }
+  {
+    filter f(100000);
+    if(f.capacity()>0){
+      external_buffer<filter_view,filter> eb(f);
+      BOOST_TEST_THROWS(
+        (void)filter_view(eb.data(),f.capacity()-1),
+        std::invalid_argument);
+      BOOST_TEST_THROWS(
+        (void)filter_view(nullptr,f.capacity()),std::invalid_argument);
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_filter_view<filter,value_factory<value_type>>();
+  }
+};
+
+void test_alignment()
+{
+  using filter=boost::bloom::filter<int,1,boost::bloom::block<
+    boost::uint64_t,3>>;
+  using filter_view=boost::bloom::filter_view<int,1,boost::bloom::block<
+    boost::uint64_t,3>>;
+
+  filter                              f(1000);
+  external_buffer<filter_view,filter> eb(f);
+  BOOST_TEST_THROWS(
+    (void)filter_view(eb.data()+1,f.capacity()),std::invalid_argument);
+}
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  test_alignment();
+  return boost::report_errors();
+}
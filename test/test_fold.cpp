@@ -0,0 +1,180 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/bloom/fast_block.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/filter_view.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/serialization.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct view_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
+>
+struct view_for_impl<boost::bloom::filter<T,K,S,B,H,A,HS>>
+{
+  using type=boost::bloom::filter_view<T,K,S,B,H,HS>;
+};
+
+template<typename Filter>
+using view_for=typename view_for_impl<Filter>::type;
+
+template<typename Filter>
+void test_fold()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+  static constexpr bool non_overlapping=
+    filter::bucket_size==
+    boost::bloom::detail::used_value_size<typename filter::subfilter>::value;
+
+  std::vector<value_type> input;
+  value_factory<value_type> fac;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+
+  filter f(100000);
+  for(const auto& x:input)f.insert(x);
+
+  for(std::size_t levels=1;levels<=4;++levels){
+    filter f2(f);
+    f2.fold(levels);
+    BOOST_TEST_LT(f2.capacity(),f.capacity());
+    BOOST_TEST(may_contain(f2,input));
+
+    /* same as inserting into a filter with the folded capacity, save for
+     * overlapping buckets
+     */
+
+    filter f3(f2.capacity());
+    BOOST_TEST_EQ(f3.capacity(),f2.capacity());
+    for(const auto& x:input)f3.insert(x);
+    BOOST_TEST(f3.is_subset_of(f2));
+    if(non_overlapping)BOOST_TEST(f3==f2);
+
+    /* folding in steps */
+
+    filter f4(f);
+    for(std::size_t i=0;i<levels;++i)f4.fold();
+    BOOST_TEST(f4==f2);
+
+    /* fold on serialization */
+
+    std::ostringstream out;
+    boost::bloom::save(f,out,boost::bloom::serialization_format::raw,levels);
+    {
+      filter             f5;
+      std::istringstream in(out.str());
+      boost::bloom::load(f5,in);
+      BOOST_TEST(f5==f2);
+    }
+
+    std::vector<unsigned char> buf;
+    boost::bloom::save(
+      view_for<filter>(f),buf,
+      boost::bloom::serialization_format::compressed,levels);
+    {
+      filter f5;
+      boost::bloom::load(f5,buf.data(),buf.size());
+      BOOST_TEST(f5==f2);
+    }
+  }
+
+  {
+    filter f2(f);
+    f2.fold(0);
+    BOOST_TEST(f2==f);
+  }
+  {
+    filter f2(1);
+    filter f3(f2);
+    BOOST_TEST_THROWS(f2.fold(1),std::invalid_argument);
+    BOOST_TEST_THROWS(f2.fold(100),std::invalid_argument);
+    BOOST_TEST(f2==f3);
+  }
+  {
+    filter f2;
+    f2.fold(3);
+    BOOST_TEST_EQ(f2.capacity(),0u);
+
+    std::ostringstream out;
+    boost::bloom::save(f2,out,boost::bloom::serialization_format::raw,3);
+    filter             f3(1000);
+    std::istringstream in(out.str());
+    boost::bloom::load(f3,in);
+    BOOST_TEST_EQ(f3.capacity(),0u);
+  }
+}
+
+void test_unfoldable()
+{
+  using filter=boost::bloom::filter<int,3>;
+
+  filter f(10000);
+  for(int i=0;i<100;++i)f.insert(i);
+
+  std::ostringstream out;
+  BOOST_TEST_THROWS(
+    boost::bloom::save(f,out,boost::bloom::serialization_format::raw,1),
+    std::invalid_argument);
+}
+
+template<typename T,std::size_t K,typename Subfilter,std::size_t B=0>
+using foldable_filter=boost::bloom::filter<
+  T,K,Subfilter,B,boost::hash<T>,std::allocator<T>,
+  boost::bloom::mask_and_remix>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_fold<typename T::type>();
+  }
+};
+
+int main()
+{
+  using namespace boost::bloom;
+
+  using fold_test_types=boost::mp11::mp_list<
+    foldable_filter<int,3,block<unsigned char,1>>,
+    foldable_filter<std::string,1,block<boost::uint16_t,3>,1>,
+    foldable_filter<std::size_t,2,multiblock<boost::uint64_t,3>>,
+    foldable_filter<int,1,fast_multiblock32<5>,2>,
+    foldable_filter<std::size_t,1,fast_block<7,512>,16>,
+    concurrent_filter<
+      int,2,block<boost::uint32_t,2>,0,
+      boost::hash<int>,std::allocator<int>,mask_and_remix>
+  >;
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,fold_test_types>
+  >(lambda{});
+  test_unfoldable();
+  return boost::report_errors();
+}
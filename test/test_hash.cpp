@@ -0,0 +1,79 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <iterator>
+#include <list>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_hash()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input1,input2;
+  for(std::size_t i=0;i<1000;++i){
+    input1.push_back(fac());
+    input2.push_back(fac());
+  }
+
+  filter                       f1(10000),f2(10000),f3(10000);
+  std::vector<boost::uint64_t> hashes1,hashes2;
+  for(const auto& x:input1){
+    auto hash=f1.hash_for(x);
+    BOOST_TEST_EQ(hash,filter::mix_hash(f1.hash_function()(x)));
+    hashes1.push_back(hash);
+  }
+  for(const auto& x:input2)hashes2.push_back(f1.hash_for(x));
+
+  f1.insert(input1.begin(),input1.end());
+  for(auto hash:hashes1)f2.insert_hash(hash);
+  std::list<boost::uint64_t> l(hashes1.begin(),hashes1.end());
+  f3.insert_hash(l.begin(),l.end());
+  BOOST_TEST(f1==f2);
+  BOOST_TEST(f1==f3);
+
+  for(const auto& hashes:{hashes1,hashes2}){
+    std::vector<bool> res1,res2;
+    for(auto hash:hashes)res1.push_back(f1.may_contain_hash(hash));
+    f1.may_contain_hash(hashes.begin(),hashes.end(),std::back_inserter(res2));
+    BOOST_TEST(res1==res2);
+  }
+  {
+    std::vector<bool> res1,res2;
+    f1.may_contain(input2.begin(),input2.end(),std::back_inserter(res1));
+    f1.may_contain_hash(hashes2.begin(),hashes2.end(),std::back_inserter(res2));
+    BOOST_TEST(res1==res2);
+  }
+  for(auto hash:hashes1)BOOST_TEST(f1.may_contain_hash(hash));
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_hash<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
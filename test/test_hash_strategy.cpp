@@ -0,0 +1,167 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
+#include <boost/bloom/serialization.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template<typename HashStrategy>
+using filter_for=boost::bloom::filter<
+  int,3,boost::bloom::block<unsigned char,1>,0,
+  boost::hash<int>,std::allocator<int>,HashStrategy>;
+
+template<typename HashStrategy>
+bool is_exact_range()
+{
+  return
+    std::is_same<HashStrategy,boost::bloom::fastrange32>::value||
+    std::is_same<HashStrategy,boost::bloom::double_hashing>::value;
+}
+
+template<typename HashStrategy>
+void test_range()
+{
+  static constexpr std::size_t empty_range=HashStrategy{0}.range();
+  BOOST_TEST_GT(empty_range,0u);
+
+  for(std::size_t m:{
+    std::size_t(1),std::size_t(2),std::size_t(3),std::size_t(1000),
+    std::size_t(1024),std::size_t(1025),std::size_t(123457)}){
+    HashStrategy hs{m};
+    std::size_t  rng=hs.range();
+    BOOST_TEST_GE(rng,m);
+    if(std::is_same<HashStrategy,boost::bloom::mask_and_remix>::value){
+      BOOST_TEST_EQ(rng&(rng-1),0u);
+      BOOST_TEST_LT(rng/2,m);
+    }
+    if(is_exact_range<HashStrategy>())BOOST_TEST_EQ(rng,m);
+
+    /* positions are in range and roughly uniformly distributed */
+
+    static constexpr std::size_t num_cells=16,samples_per_cell=4000;
+    std::vector<std::size_t>     cells(num_cells);
+    boost::detail::splitmix64    gen;
+    for(std::size_t i=0;i<num_cells*samples_per_cell/4;++i){
+      boost::uint64_t hash=gen();
+      hs.prepare_hash(hash);
+      for(int j=0;j<4;++j){
+        std::size_t pos=hs.next_position(hash);
+        BOOST_TEST_LT(pos,rng);
+        ++cells[(std::size_t)((double)pos/rng*num_cells)];
+      }
+    }
+    if(rng>=num_cells*num_cells){
+      for(auto n:cells){
+        BOOST_TEST_GT(n,samples_per_cell*8/10);
+        BOOST_TEST_LT(n,samples_per_cell*12/10);
+      }
+    }
+  }
+
+  if(is_exact_range<HashStrategy>()&&
+     std::numeric_limits<std::size_t>::digits>32){
+    BOOST_TEST_THROWS(
+      (void)HashStrategy{(std::numeric_limits<std::size_t>::max)()},
+      std::length_error);
+  }
+}
+
+template<typename HashStrategy>
+void test_filter()
+{
+  using filter=filter_for<HashStrategy>;
+
+  static_assert(
+    std::is_same<typename filter::hash_strategy,HashStrategy>::value,"");
+
+  for(std::size_t m:{std::size_t(8000),std::size_t(8001),std::size_t(65536)}){
+    filter f(m);
+    if(is_exact_range<HashStrategy>()){
+      BOOST_TEST_EQ(f.capacity(),(m+CHAR_BIT-1)/CHAR_BIT*CHAR_BIT);
+    }
+    BOOST_TEST_EQ(filter::capacity_for(1000,0.01),filter(1000,0.01).capacity());
+
+    for(int i=0;i<1000;++i)f.insert(i);
+    for(int i=0;i<1000;++i)BOOST_TEST(f.may_contain(i));
+
+    filter f2(f.capacity());
+    std::vector<int> input;
+    for(int i=0;i<1000;++i)input.push_back(i);
+    f2.insert(input.begin(),input.end());
+    BOOST_TEST(f2==f);
+  }
+}
+
+template<typename HashStrategy>
+void test_serialization()
+{
+  using filter=filter_for<HashStrategy>;
+  using default_filter=filter_for<boost::bloom::mcg_and_fastrange>;
+
+  filter f(10000);
+  for(int i=0;i<100;++i)f.insert(i);
+
+  std::ostringstream out;
+  boost::bloom::save(f,out);
+  {
+    filter             f2;
+    std::istringstream in(out.str());
+    boost::bloom::load(f2,in);
+    BOOST_TEST(f2==f);
+  }
+
+  /* filters with different hash strategies are not interchangeable */
+
+  if(!std::is_same<HashStrategy,boost::bloom::mcg_and_fastrange>::value){
+    default_filter     f2;
+    std::istringstream in(out.str());
+    BOOST_TEST_THROWS(boost::bloom::load(f2,in),std::invalid_argument);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using hash_strategy=typename T::type;
+
+    test_range<hash_strategy>();
+    test_filter<hash_strategy>();
+    test_serialization<hash_strategy>();
+  }
+};
+
+int main()
+{
+  using hash_strategies=boost::mp11::mp_list<
+    boost::bloom::mcg_and_fastrange,
+    boost::bloom::mask_and_remix,
+    boost::bloom::fastrange32,
+    boost::bloom::double_hashing
+  >;
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,hash_strategies>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,97 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/huge_page_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstring>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+void test_allocation()
+{
+  using allocator=boost::bloom::huge_page_allocator<unsigned char>;
+  using flags=boost::bloom::huge_page_flags;
+
+  static constexpr std::size_t mb=std::size_t(1)<<20;
+
+  for(unsigned int f:{
+    flags::none,flags::explicit_huge_pages,flags::populate,flags::lock,
+    flags::interleave,flags::populate|flags::interleave,
+    flags::explicit_huge_pages|flags::populate|flags::lock}){
+    allocator al{f};
+    BOOST_TEST_EQ(al.get_flags(),f);
+    BOOST_TEST(al==boost::bloom::huge_page_allocator<int>{});
+
+    for(std::size_t n:{
+      std::size_t(1),std::size_t(4095),std::size_t(4097),
+      2*mb-1,2*mb,2*mb+1,5*mb}){
+      auto p=al.allocate(n);
+      BOOST_TEST(p!=nullptr);
+      BOOST_TEST_EQ(boost::uintptr_t(p)%allocator::alignment,0u);
+#if defined(BOOST_BLOOM_HUGE_PAGES)
+      if(n>=2*mb)BOOST_TEST_EQ(boost::uintptr_t(p)%(2*mb),0u);
+#endif
+      std::memset(p,0xAA,n);
+      BOOST_TEST_EQ(p[n-1],0xAA);
+      al.deallocate(p,n);
+    }
+  }
+}
+
+template<typename Filter,typename ValueFactory>
+void test_filter()
+{
+  using filter=Filter;
+  using hp_filter=realloc_filter<
+    filter,boost::bloom::huge_page_allocator<typename filter::value_type>>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<10000;++i)input.push_back(fac());
+
+  for(std::size_t m:{0,1000,100000,1<<25}){
+    filter    f1(input.begin(),input.end(),m);
+    hp_filter f2(input.begin(),input.end(),m);
+    BOOST_TEST_EQ(f1.capacity(),f2.capacity());
+    BOOST_TEST_EQ(f1.array().size(),f2.array().size());
+    BOOST_TEST(std::memcmp(
+      f1.array().data(),f2.array().data(),f1.array().size())==0);
+    BOOST_TEST(may_contain(f2,input));
+
+    hp_filter f3(f2);
+    BOOST_TEST(f3==f2);
+    f3.reset(m*2);
+    f3.insert(input.begin(),input.end());
+    BOOST_TEST(may_contain(f3,input));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  test_allocation();
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
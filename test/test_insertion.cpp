@@ -9,7 +9,9 @@
 #include <boost/core/lightweight_test.hpp>
 #include <array>
 #include <boost/mp11/algorithm.hpp>
+#include <list>
 #include <utility>
+#include <vector>
 #include "test_types.hpp"
 #include "test_utilities.hpp"
 
@@ -93,6 +95,57 @@ void test_insertion()
   }
 }
 
+template<typename Filter,typename ValueFactory>
+void test_range_insertion()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  for(std::size_t n:{0,1,31,32,33,1000}){
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<n;++i)input.push_back(fac());
+
+    filter f1(n*4),f2(n*4);
+    f1.insert(input.begin(),input.end());
+    for(const auto& x:input)f2.insert(x);
+    BOOST_TEST(f1==f2);
+    BOOST_TEST(may_contain(f1,input));
+
+    std::list<value_type> l(input.begin(),input.end());
+    filter                f3(l.begin(),l.end(),n*4);
+    BOOST_TEST(f3==f2);
+  }
+  {
+    filter                  f;
+    std::vector<value_type> input={fac(),fac()};
+    f.insert(input.begin(),input.end());
+    f.insert_partitioned(input.begin(),input.end());
+    BOOST_TEST_EQ(f.capacity(),0u);
+  }
+}
+
+template<typename Filter,typename ValueFactory>
+void test_partitioned_insertion()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  /* large enough capacity to trigger radix partitioning */
+  for(std::size_t m:{std::size_t(10000),std::size_t(1)<<28}){
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<100000;++i)input.push_back(fac());
+
+    filter f1(m),f2(m);
+    f1.insert_partitioned(input.begin(),input.end());
+    for(const auto& x:input)f2.insert(x);
+    BOOST_TEST(f1==f2);
+  }
+}
+
 struct lambda
 {
   template<typename T>
@@ -102,6 +155,8 @@ struct lambda
     using value_type=typename filter::value_type;
 
     test_insertion<filter,value_factory<value_type>>();
+    test_range_insertion<filter,value_factory<value_type>>();
+    test_partitioned_insertion<filter,value_factory<value_type>>();
   }
 };
 
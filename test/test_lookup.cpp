@@ -0,0 +1,145 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename Input>
+std::vector<bool> scalar_may_contain(const Filter& f,const Input& input)
+{
+  std::vector<bool> res;
+  for(const auto& x:input)res.push_back(f.may_contain(x));
+  return res;
+}
+
+template<typename Filter,typename ValueFactory>
+void test_lookup()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  {
+    const filter      f;
+    std::vector<bool> res;
+    value_type        x=fac();
+
+    f.may_contain(&x,&x,std::back_inserter(res));
+    BOOST_TEST(res.empty());
+    f.may_contain(&x,&x+1,std::back_inserter(res));
+    BOOST_TEST_EQ(res.size(),1u);
+    BOOST_TEST(res[0]);
+
+    boost::uint32_t sel=1;
+    BOOST_TEST_EQ(
+      f.may_contain_selection(boost::span<const value_type>(),{}),0u);
+    BOOST_TEST_EQ(f.may_contain_selection({&x,1},{&sel,1}),1u);
+    BOOST_TEST_EQ(sel,0u);
+  }
+
+  for(std::size_t n:{1,15,16,17,100,1000}){
+    std::vector<value_type> input1,input2;
+    for(std::size_t i=0;i<n;++i){
+      input1.push_back(fac());
+      input2.push_back(fac());
+    }
+
+    const filter f(input1.begin(),input1.end(),n*4);
+    {
+      std::vector<bool> res;
+      auto              it=f.may_contain(
+        input1.begin(),input1.end(),std::back_inserter(res));
+      (void)it;
+      BOOST_TEST_EQ(res.size(),n);
+      BOOST_TEST(res==scalar_may_contain(f,input1));
+    }
+    {
+      std::list<value_type> l(input2.begin(),input2.end());
+      std::vector<bool>     res;
+      f.may_contain(l.begin(),l.end(),std::back_inserter(res));
+      BOOST_TEST(res==scalar_may_contain(f,input2));
+    }
+    {
+      std::unique_ptr<bool[]> res(new bool[n+1]);
+      res[n]=false;
+      auto it=f.may_contain(input2.begin(),input2.end(),res.get());
+      BOOST_TEST_EQ(it,res.get()+n);
+      BOOST_TEST(
+        std::vector<bool>(res.get(),res.get()+n)==
+        scalar_may_contain(f,input2));
+      BOOST_TEST(!res[n]);
+    }
+    {
+      std::unique_ptr<bool[]> res(new bool[n]);
+      f.may_contain(input1,boost::span<bool>(res.get(),n));
+      BOOST_TEST(
+        std::vector<bool>(res.get(),res.get()+n)==
+        scalar_may_contain(f,input1));
+    }
+    for(const auto& input:{input1,input2}){
+      auto                         expected=scalar_may_contain(f,input);
+      std::vector<boost::uint32_t> sel(n);
+      std::size_t                  m=f.may_contain_selection(input,sel);
+      std::vector<bool>            res(n,false);
+      BOOST_TEST_LE(m,n);
+      for(std::size_t i=0;i<m;++i){
+        BOOST_TEST_LT(sel[i],n);
+        if(i>0)BOOST_TEST_LT(sel[i-1],sel[i]);
+        res[sel[i]]=true;
+      }
+      BOOST_TEST(res==expected);
+
+      std::vector<boost::uint64_t> bitmap((n+63)/64,~boost::uint64_t(0));
+      f.may_contain_bitmap(input,bitmap);
+      for(std::size_t i=0;i<n;++i)res[i]=(bitmap[i/64]>>(i%64))&1;
+      BOOST_TEST(res==expected);
+      if(n%64)BOOST_TEST_EQ(bitmap.back()>>(n%64),0u);
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_lookup<filter,value_factory<value_type>>();
+  }
+};
+
+/* subfilters with a batch_check kernel */
+
+using batch_check_test_types=boost::mp11::mp_transform<
+  boost::mp11::mp_identity,
+  boost::mp11::mp_list<
+    boost::bloom::filter<int,1,boost::bloom::block<boost::uint32_t,4>>,
+    boost::bloom::filter<int,1,boost::bloom::block<boost::uint32_t,13>,1>,
+    boost::bloom::filter<int,1,boost::bloom::block<boost::uint64_t,12>>,
+    boost::bloom::filter<int,1,boost::bloom::multiblock<boost::uint32_t,5>>,
+    boost::bloom::filter<int,1,boost::bloom::multiblock<boost::uint64_t,10>,3>
+  >
+>;
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  boost::mp11::mp_for_each<batch_check_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,82 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <iterator>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_multi()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  for(std::size_t num_filters:{1,15,16,17,40}){
+    std::vector<filter> fs1,fs2;
+    for(std::size_t i=0;i<num_filters;++i){
+      fs1.emplace_back(1000+i*100); /* different capacities */
+      if(i%5==0)fs1.back().reset(); /* and some null filters */
+    }
+    fs2=fs1;
+
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<100;++i)input.push_back(fac());
+    for(std::size_t i=0;i<input.size();++i){
+      boost::bloom::multi_insert(
+        fs1.begin()+(i%num_filters),fs1.end(),input[i]);
+      for(std::size_t j=i%num_filters;j<num_filters;++j){
+        fs2[j].insert(input[i]);
+      }
+    }
+    BOOST_TEST(fs1==fs2);
+
+    for(std::size_t i=0;i<input.size()*2;++i){
+      auto              x=i<input.size()?input[i]:fac();
+      std::vector<bool> res1,res2;
+      auto              it=boost::bloom::multi_may_contain(
+        fs1.cbegin(),fs1.cend(),x,std::back_inserter(res1));
+      (void)it;
+      for(const auto& f:fs1)res2.push_back(f.may_contain(x));
+      BOOST_TEST(res1==res2);
+    }
+  }
+  {
+    std::vector<filter> fs;
+    std::vector<bool>   res;
+    value_type          x=fac();
+    boost::bloom::multi_insert(fs.begin(),fs.end(),x);
+    boost::bloom::multi_may_contain(
+      fs.begin(),fs.end(),x,std::back_inserter(res));
+    BOOST_TEST(res.empty());
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_multi<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,112 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/thread_executor.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_parallel()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<100000;++i)input.push_back(fac());
+
+  boost::bloom::thread_executor ex(4);
+
+  for(std::size_t m:{0,1000,1<<22}){
+    for(std::size_t n:{0,10,1000,100000}){
+      filter f1(m);
+      f1.insert(input.begin(),input.begin()+n);
+      {
+        filter f2(m);
+        f2.insert(ex,input.begin(),input.begin()+n);
+        BOOST_TEST(f1==f2);
+      }
+      {
+        filter f2(m);
+        f2.insert(reverse_serial_executor{},input.begin(),input.begin()+n);
+        BOOST_TEST(f1==f2);
+      }
+      {
+        filter f2(ex,input.begin(),input.begin()+n,m);
+        BOOST_TEST(f1==f2);
+      }
+#if defined(BOOST_BLOOM_PARALLEL_ALGORITHMS)
+      {
+        filter f2(m);
+        f2.insert(std::execution::par,input.begin(),input.begin()+n);
+        BOOST_TEST(f1==f2);
+      }
+#endif
+    }
+  }
+  {
+    filter f1(input.begin(),input.end(),input.size(),0.01),
+           f2(ex,input.begin(),input.end(),input.size(),0.01);
+    BOOST_TEST(f1==f2);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_parallel<filter,value_factory<value_type>>();
+  }
+};
+
+void test_thread_executor()
+{
+  for(std::size_t num_threads:{0,1,3}){
+    boost::bloom::thread_executor ex(num_threads);
+    BOOST_TEST_EQ(ex.num_threads(),num_threads?num_threads:1);
+
+    for(std::size_t n:{0,1,1000}){
+      std::vector<std::atomic<int>> v(n);
+      for(auto& x:v)x=0;
+      ex(n,[&](std::size_t i){++v[i];});
+      std::size_t res=0;
+      for(auto& x:v)res+=(x==1);
+      BOOST_TEST_EQ(res,n);
+    }
+
+    BOOST_TEST_THROWS(
+      ex(100,[](std::size_t i){
+        if(i==50)throw std::runtime_error("");
+      }),
+      std::runtime_error);
+
+    /* executor is reusable after an exception */
+
+    std::atomic<std::size_t> count{0};
+    ex(100,[&](std::size_t){++count;});
+    BOOST_TEST_EQ(count,100u);
+  }
+}
+
+int main()
+{
+  test_thread_executor();
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,151 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/bloom/replicated_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <thread>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename ReplicatedFilter,typename Filter>
+bool all_replicas_equal(const ReplicatedFilter& rf,const Filter& f)
+{
+  for(std::size_t i=0;i<rf.num_replicas();++i){
+    if(rf.replica(i)!=f)return false;
+  }
+  return true;
+}
+
+template<typename Filter,typename ValueFactory>
+void test_replicated_filter()
+{
+  using filter=Filter;
+  using replicated_filter=boost::bloom::replicated_filter<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  {
+    replicated_filter rf(filter(1000));
+    BOOST_TEST_GE(rf.num_replicas(),1u);
+    BOOST_TEST_EQ(rf.capacity(),filter(1000).capacity());
+  }
+  for(std::size_t num_replicas:{0,1,3}){
+    filter f(10000);
+    f.insert(input.begin(),input.begin()+100);
+
+    replicated_filter rf(f,num_replicas);
+    BOOST_TEST_EQ(rf.num_replicas(),num_replicas?num_replicas:1);
+    BOOST_TEST_LT(rf.local_replica_index(),rf.num_replicas());
+    BOOST_TEST_EQ(rf.capacity(),f.capacity());
+    BOOST_TEST(all_replicas_equal(rf,f));
+
+    /* propagated writes */
+
+    rf.insert(input[100]);
+    f.insert(input[100]);
+    rf.insert(input.begin()+101,input.begin()+200);
+    f.insert(input.begin()+101,input.begin()+200);
+    BOOST_TEST(all_replicas_equal(rf,f));
+    BOOST_TEST(may_contain(
+      rf,std::vector<value_type>(input.begin(),input.begin()+200)));
+
+    /* local writes plus synchronization */
+
+    auto first=input.begin()+200;
+    for(std::size_t i=0;i<rf.num_replicas();++i){
+      auto last=first+100;
+      rf.replica(i).insert(first,last);
+      first=last;
+    }
+    rf.insert_local(*first++);
+    rf.insert_local(first,first+99);
+    first+=99;
+    f.insert(input.begin()+200,first);
+    if(rf.num_replicas()>1)BOOST_TEST(!all_replicas_equal(rf,f));
+    rf.synchronize();
+    BOOST_TEST(all_replicas_equal(rf,f));
+    BOOST_TEST(may_contain(rf,std::vector<value_type>(input.begin(),first)));
+
+    replicated_filter rf2(rf);
+    BOOST_TEST_EQ(rf2.num_replicas(),rf.num_replicas());
+    BOOST_TEST(all_replicas_equal(rf2,f));
+
+    rf.clear();
+    BOOST_TEST(all_replicas_equal(rf,filter(10000)));
+    BOOST_TEST(all_replicas_equal(rf2,f));
+
+    rf=std::move(rf2);
+    BOOST_TEST(all_replicas_equal(rf,f));
+
+    /* synchronize requires equal capacities */
+
+    if(rf.num_replicas()>1){
+      rf.replica(0).reset(100000);
+      BOOST_TEST_THROWS(rf.synchronize(),std::invalid_argument);
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_replicated_filter<filter,value_factory<value_type>>();
+  }
+};
+
+/* concurrent local writes and lookups on replicas of a concurrent_filter */
+
+void test_concurrent_replicas()
+{
+  using filter=boost::bloom::concurrent_filter<int,3>;
+  using replicated_filter=boost::bloom::replicated_filter<filter>;
+
+  static constexpr std::size_t num_threads=4,
+                               num_elements=20000;
+
+  replicated_filter        rf(filter(num_elements*10),3);
+  std::vector<std::thread> threads;
+  for(std::size_t t=0;t<num_threads;++t){
+    threads.emplace_back([&,t]{
+      for(std::size_t i=t;i<num_elements;i+=num_threads){
+        rf.insert_local((int)i);
+        (void)rf.may_contain((int)i);
+      }
+    });
+  }
+  for(auto& th:threads)th.join();
+  rf.synchronize();
+
+  std::size_t res=0;
+  for(std::size_t i=0;i<num_elements;++i){
+    for(std::size_t j=0;j<rf.num_replicas();++j){
+      res+=rf.replica(j).may_contain((int)i);
+    }
+  }
+  BOOST_TEST_EQ(res,num_elements*rf.num_replicas());
+}
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  test_concurrent_replicas();
+  return boost::report_errors();
+}
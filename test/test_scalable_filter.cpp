@@ -0,0 +1,156 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/scalable_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_scalable_filter()
+{
+  using filter=Filter;
+  using scalable_filter=boost::bloom::scalable_filter<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+
+  {
+    scalable_filter sf(100,0.01);
+    BOOST_TEST_EQ(sf.num_stages(),1u);
+    BOOST_TEST_EQ(sf.size(),0u);
+    BOOST_TEST_EQ(sf.fpr(),0.01);
+    BOOST_TEST_EQ(sf.capacity(),sf.stage(0).capacity());
+    BOOST_TEST_EQ(sf.estimated_fpr(),0.0);
+  }
+  {
+    scalable_filter sf(0,0.01);
+    sf.insert(input[0]);
+    sf.insert(input[1]);
+    BOOST_TEST_EQ(sf.num_stages(),2u);
+    BOOST_TEST(sf.may_contain(input[0]));
+    BOOST_TEST(sf.may_contain(input[1]));
+  }
+  {
+    scalable_filter sf(100,0.01);
+    sf.insert(input.begin(),input.begin()+100);
+    BOOST_TEST_EQ(sf.num_stages(),1u);
+
+    /* stages of 100, 200, 400, 800, 1600 elements */
+
+    sf.insert(input[100]);
+    BOOST_TEST_EQ(sf.num_stages(),2u);
+    sf.insert(input.begin()+101,input.end());
+    BOOST_TEST_EQ(sf.num_stages(),5u);
+    BOOST_TEST_EQ(sf.size(),input.size());
+    BOOST_TEST(may_contain(sf,input));
+
+    std::size_t capacity=0;
+    for(std::size_t i=0;i<sf.num_stages();++i){
+      capacity+=sf.stage(i).capacity();
+      if(i>0){
+        BOOST_TEST_GE(sf.stage(i).capacity(),sf.stage(i-1).capacity());
+      }
+    }
+    BOOST_TEST_EQ(sf.capacity(),capacity);
+    BOOST_TEST_GT(sf.estimated_fpr(),0.0);
+    BOOST_TEST_LT(sf.estimated_fpr(),1.0);
+
+    /* bulk lookup matches element-wise lookup */
+
+    std::vector<value_type> lookup(input.begin(),input.begin()+500);
+    for(int i=0;i<500;++i)lookup.push_back(fac());
+    std::unique_ptr<bool[]> res(new bool[lookup.size()]);
+    BOOST_TEST(
+      sf.may_contain(lookup.begin(),lookup.end(),res.get())==
+      res.get()+lookup.size());
+    for(std::size_t i=0;i<lookup.size();++i){
+      BOOST_TEST_EQ(res[i],sf.may_contain(lookup[i]));
+    }
+
+    scalable_filter sf2(sf);
+    BOOST_TEST_EQ(sf2.num_stages(),sf.num_stages());
+    BOOST_TEST(may_contain(sf2,input));
+
+    sf.clear();
+    BOOST_TEST_EQ(sf.num_stages(),1u);
+    BOOST_TEST_EQ(sf.size(),0u);
+    BOOST_TEST(sf.stage(0)==filter(100,0.005));
+    sf.insert(input.begin(),input.begin()+100);
+    BOOST_TEST_EQ(sf.num_stages(),1u);
+    BOOST_TEST(may_contain(sf,
+      std::vector<value_type>(input.begin(),input.begin()+100)));
+
+    sf=std::move(sf2);
+    BOOST_TEST_EQ(sf.num_stages(),5u);
+    BOOST_TEST(may_contain(sf,input));
+  }
+  {
+    BOOST_TEST_THROWS(scalable_filter(100,0.0),std::invalid_argument);
+    BOOST_TEST_THROWS(scalable_filter(100,1.0),std::invalid_argument);
+    BOOST_TEST_THROWS(scalable_filter(100,0.01,0.5),std::invalid_argument);
+    BOOST_TEST_THROWS(
+      scalable_filter(100,0.01,2.0,0.0),std::invalid_argument);
+    BOOST_TEST_THROWS(
+      scalable_filter(100,0.01,2.0,1.0),std::invalid_argument);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_scalable_filter<filter,value_factory<value_type>>();
+  }
+};
+
+/* compound FPR stays within target as the filter grows */
+
+void test_scalable_fpr()
+{
+  using filter=boost::bloom::filter<int,5>;
+  using scalable_filter=boost::bloom::scalable_filter<filter>;
+
+  for(double fpr:{0.1,0.01,0.001}){
+    for(double growth:{1.5,2.0,4.0}){
+      static constexpr int num_elements=100000,
+                           num_lookups=200000;
+
+      scalable_filter sf(1000,fpr,growth);
+      for(int i=0;i<num_elements;++i)sf.insert(i);
+      BOOST_TEST_GT(sf.num_stages(),1u);
+      BOOST_TEST_LT(sf.estimated_fpr(),fpr*1.2);
+
+      int res=0;
+      for(int i=num_elements;i<num_elements+num_lookups;++i){
+        res+=sf.may_contain(i);
+      }
+      BOOST_TEST_LT((double)res/num_lookups,fpr*1.2);
+    }
+  }
+}
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  test_scalable_fpr();
+  return boost::report_errors();
+}
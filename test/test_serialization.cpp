@@ -0,0 +1,451 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/bloom/detail/compression.hpp>
+#include <boost/bloom/detail/crc32c.hpp>
+#include <boost/bloom/serialization.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct rekey_filter_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  typename HS
+>
+struct rekey_filter_impl<boost::bloom::filter<T,K,S,B,H,A,HS>>
+{
+  using type=boost::bloom::filter<T,K+1,S,B,H,A,HS>;
+  using view=boost::bloom::filter_view<T,K,S,B,H,HS>;
+};
+
+template<typename Filter>
+using rekey_filter=typename rekey_filter_impl<Filter>::type;
+
+template<typename Filter>
+using filter_view_for=typename rekey_filter_impl<Filter>::view;
+
+/* serialized data copied at a 64-byte aligned position */
+
+struct aligned_buffer
+{
+  aligned_buffer(const std::string& str):buf(str.size()+64)
+  {
+    std::memcpy(data(),str.data(),str.size());
+  }
+
+  unsigned char* data()
+  {
+    auto p=buf.data();
+    return p+(64-boost::uintptr_t(p)%64)%64;
+  }
+
+  std::vector<unsigned char> buf;
+};
+
+template<typename Filter>
+std::string save_to_string(
+  const Filter& f,
+  boost::bloom::serialization_format fmt=
+    boost::bloom::serialization_format::raw)
+{
+  std::ostringstream os;
+  boost::bloom::save(f,os,fmt);
+  return os.str();
+}
+
+template<typename Filter>
+void load_from_string(Filter& f,const std::string& str)
+{
+  std::istringstream is(str);
+  boost::bloom::load(f,is);
+}
+
+template<typename Filter>
+void merge_from_string(Filter& f,const std::string& str)
+{
+  std::istringstream is(str);
+  boost::bloom::merge(f,is);
+}
+
+template<typename Filter,typename ValueFactory>
+void test_serialization()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+  using filter_view=filter_view_for<filter>;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  for(std::size_t m:{0,1000,100000}){
+    filter f1(m);
+    f1.insert(input.begin(),input.end());
+    auto str=save_to_string(f1);
+    BOOST_TEST_EQ(
+      str.size(),
+      boost::bloom::serialization_header::size+f1.array().size()+
+      filter_view::trailing_padding);
+
+    {
+      filter f2(1000);
+      load_from_string(f2,str);
+      BOOST_TEST(f1==f2);
+      BOOST_TEST(may_contain(f2,input));
+    }
+    {
+      rekey_filter<filter> f2;
+      BOOST_TEST_THROWS(load_from_string(f2,str),std::invalid_argument);
+    }
+    {
+      filter f2;
+      BOOST_TEST_THROWS(
+        load_from_string(f2,str.substr(0,str.size()-1)),std::runtime_error);
+      BOOST_TEST_EQ(f2.fill_ratio(),0.0);
+    }
+    {
+      filter f2;
+      auto   str2=str;
+      str2[20]^=1;
+      BOOST_TEST_THROWS(load_from_string(f2,str2),std::runtime_error);
+      str2=str;
+      str2[0]='X';
+      BOOST_TEST_THROWS(load_from_string(f2,str2),std::invalid_argument);
+    }
+    if(f1.array().size()){
+      filter f2;
+      auto   str2=str;
+      str2[boost::bloom::serialization_header::size+
+           f1.array().size()/2]^=0x10;
+      BOOST_TEST_THROWS(load_from_string(f2,str2),std::runtime_error);
+      BOOST_TEST_EQ(f2.fill_ratio(),0.0);
+    }
+    {
+      aligned_buffer buf(str);
+      auto           fv=boost::bloom::load_view<filter_view>(
+        buf.data(),str.size());
+      BOOST_TEST_EQ(fv.capacity(),f1.capacity());
+      BOOST_TEST(may_contain(fv,input));
+      BOOST_TEST_THROWS(
+        (void)boost::bloom::load_view<filter_view>(
+          buf.data(),str.size()-filter_view::trailing_padding-1),
+        std::runtime_error);
+      if(f1.array().size()){
+        buf.data()[boost::bloom::serialization_header::size]^=1;
+        BOOST_TEST_THROWS(
+          (void)boost::bloom::load_view<filter_view>(
+            buf.data(),str.size()),
+          std::runtime_error);
+        (void)boost::bloom::load_view<filter_view>(
+          buf.data(),str.size(),false);
+      }
+    }
+    {
+      auto header=boost::bloom::make_serialization_header(f1);
+      BOOST_TEST(std::memcmp(
+        header.data(),str.data(),boost::bloom::serialization_header::size)
+        ==0);
+      BOOST_TEST_EQ(header.capacity(),f1.capacity());
+      BOOST_TEST_EQ(
+        boost::bloom::read_serialization_header<filter>(header),
+        f1.capacity());
+      boost::bloom::verify_checksum(f1,header);
+    }
+    {
+      auto cstr=save_to_string(
+        f1,boost::bloom::serialization_format::compressed);
+      if(m==100000)BOOST_TEST_LT(cstr.size(),str.size());
+
+      filter f2(1000);
+      load_from_string(f2,cstr);
+      BOOST_TEST(f1==f2);
+
+      std::vector<unsigned char> buf;
+      boost::bloom::save(f1,buf);
+      BOOST_TEST(std::string(buf.begin(),buf.end())==str);
+      buf.clear();
+      boost::bloom::save(
+        f1,buf,boost::bloom::serialization_format::compressed);
+      BOOST_TEST(std::string(buf.begin(),buf.end())==cstr);
+      filter f3;
+      boost::bloom::load(f3,buf.data(),buf.size());
+      BOOST_TEST(f1==f3);
+      BOOST_TEST_THROWS(
+        boost::bloom::load(f3,buf.data(),buf.size()-1),std::runtime_error);
+      BOOST_TEST_THROWS(
+        load_from_string(f3,cstr.substr(0,cstr.size()-1)),
+        std::runtime_error);
+      BOOST_TEST_EQ(f3.fill_ratio(),0.0);
+
+      aligned_buffer abuf(cstr);
+      BOOST_TEST_THROWS(
+        (void)boost::bloom::load_view<filter_view>(abuf.data(),cstr.size()),
+        std::invalid_argument);
+
+      auto cstr2=cstr;
+      cstr2[cstr2.size()/2+boost::bloom::serialization_header::size/2]^=4;
+      BOOST_TEST_THROWS(load_from_string(f3,cstr2),std::runtime_error);
+      BOOST_TEST_EQ(f3.fill_ratio(),0.0);
+    }
+    {
+      filter f2(f1.capacity());
+      std::vector<value_type> input2;
+      for(int i=0;i<1000;++i)input2.push_back(fac());
+      f2.insert(input2.begin(),input2.end());
+      auto f3=f2;
+      f3|=f1;
+
+      for(auto fmt:{
+        boost::bloom::serialization_format::raw,
+        boost::bloom::serialization_format::compressed}){
+        auto str2=save_to_string(f1,fmt);
+        auto f4=f2;
+        merge_from_string(f4,str2);
+        BOOST_TEST(f4==f3);
+        boost::bloom::merge(
+          f4,(const unsigned char*)str2.data(),str2.size());
+        BOOST_TEST(f4==f3);
+
+        if(f1.array().size()){
+          f4=f2;
+          str2[(str2.size()+boost::bloom::serialization_header::size)/2]^=1;
+          BOOST_TEST_THROWS(merge_from_string(f4,str2),std::runtime_error);
+          BOOST_TEST(f4==f2);
+        }
+
+        filter f5(f1.capacity()*2+1000);
+        if(f5.capacity()!=f1.capacity()){
+          BOOST_TEST_THROWS(
+            merge_from_string(f5,save_to_string(f1,fmt)),
+            std::invalid_argument);
+        }
+      }
+    }
+#if defined(BOOST_HAS_UNISTD_H)
+    {
+      std::FILE* file=std::tmpfile();
+      BOOST_TEST(file!=nullptr);
+      if(file){
+        int fd=fileno(file);
+        boost::bloom::save(f1,fd);
+        BOOST_TEST_EQ(::lseek(fd,0,SEEK_CUR),(::off_t)str.size());
+        ::lseek(fd,0,SEEK_SET);
+        filter f2;
+        boost::bloom::load(f2,fd);
+        BOOST_TEST(f1==f2);
+        BOOST_TEST_THROWS(boost::bloom::load(f2,fd),std::runtime_error);
+        std::fclose(file);
+      }
+    }
+    {
+      std::FILE* file=std::tmpfile();
+      BOOST_TEST(file!=nullptr);
+      if(file){
+        int fd=fileno(file);
+        boost::bloom::save(
+          f1,fd,boost::bloom::serialization_format::compressed);
+        boost::bloom::save(f1,fd);
+        ::lseek(fd,0,SEEK_SET);
+        filter f2,f3(f1.capacity());
+        boost::bloom::load(f2,fd);
+        boost::bloom::merge(f3,fd);
+        BOOST_TEST(f1==f2);
+        BOOST_TEST(f1==f3);
+        std::fclose(file);
+      }
+    }
+#endif
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_serialization<filter,value_factory<value_type>>();
+  }
+};
+
+struct my_hash:boost::hash<int>{};
+
+struct my_strategy:boost::bloom::mcg_and_fastrange
+{
+  using mcg_and_fastrange::mcg_and_fastrange;
+};
+
+struct my_other_strategy:boost::bloom::mcg_and_fastrange
+{
+  using mcg_and_fastrange::mcg_and_fastrange;
+};
+
+namespace boost{
+namespace bloom{
+
+template<>
+struct hash_id<my_hash>:std::integral_constant<boost::uint64_t,42>{};
+
+template<>
+struct hash_strategy_id<my_strategy>:
+  std::integral_constant<boost::uint64_t,200>{};
+
+template<>
+struct hash_strategy_id<my_other_strategy>:
+  std::integral_constant<boost::uint64_t,201>{};
+
+} /* namespace bloom */
+} /* namespace boost */
+
+void test_interoperability()
+{
+  using filter=boost::bloom::filter<int,3,boost::bloom::block<
+    boost::uint32_t,2>>;
+  using concurrent_filter=boost::bloom::concurrent_filter<
+    int,3,boost::bloom::block<boost::uint32_t,2>>;
+  using my_filter=boost::bloom::filter<int,3,boost::bloom::block<
+    boost::uint32_t,2>,0,my_hash>;
+
+  filter f1(10000);
+  for(int i=0;i<1000;++i)f1.insert(i);
+  auto str=save_to_string(f1);
+
+  concurrent_filter f2;
+  load_from_string(f2,str);
+  BOOST_TEST(save_to_string(f2)==str);
+
+  my_filter f3;
+  BOOST_TEST_THROWS(load_from_string(f3,str),std::invalid_argument);
+
+  /* boost::hash and std::hash are told apart, and so are their
+   * instantiations for different fundamental types
+   */
+
+  using std_hash_filter=boost::bloom::filter<int,3,boost::bloom::block<
+    boost::uint32_t,2>,0,std::hash<int>>;
+
+  std_hash_filter f7;
+  BOOST_TEST_THROWS(load_from_string(f7,str),std::invalid_argument);
+  BOOST_TEST_NE(
+    boost::bloom::hash_id<boost::hash<int>>::value,
+    boost::bloom::hash_id<boost::hash<long>>::value);
+  BOOST_TEST_NE(
+    boost::bloom::hash_id<boost::hash<std::string>>::value,
+    boost::bloom::hash_id<std::hash<std::string>>::value);
+
+  /* user-defined hash strategies are told apart by their hash_strategy_id */
+
+  using my_strategy_filter=boost::bloom::filter<int,3,boost::bloom::block<
+    boost::uint32_t,2>,0,boost::hash<int>,std::allocator<int>,my_strategy>;
+  using my_other_strategy_filter=boost::bloom::filter<int,3,
+    boost::bloom::block<boost::uint32_t,2>,0,boost::hash<int>,
+    std::allocator<int>,my_other_strategy>;
+
+  my_strategy_filter f4(10000);
+  for(int i=0;i<1000;++i)f4.insert(i);
+  auto str2=save_to_string(f4);
+
+  my_strategy_filter f5;
+  load_from_string(f5,str2);
+  BOOST_TEST(f5==f4);
+
+  my_other_strategy_filter f6;
+  BOOST_TEST_THROWS(load_from_string(f6,str2),std::invalid_argument);
+  BOOST_TEST_THROWS(load_from_string(f1,str2),std::invalid_argument);
+}
+
+void test_crc32c()
+{
+  using boost::bloom::detail::crc32c;
+
+  BOOST_TEST_EQ(crc32c((const unsigned char*)"123456789",9),0xE3069283u);
+
+  std::vector<unsigned char> data(200000);
+  boost::uint32_t            x=1;
+  for(auto& c:data){
+    x=x*1103515245u+12345u;
+    c=(unsigned char)(x>>16);
+  }
+  for(std::size_t n:{0,1,7,8,9,1000,49151,49152,49153,200000-1}){
+    auto p=data.data()+(data.size()-n);
+    auto crc=crc32c(p,n);
+    BOOST_TEST_EQ(
+      crc,~boost::bloom::detail::crc32c_sw(0xFFFFFFFFu,p,n));
+    BOOST_TEST_EQ(crc,crc32c(p+n/3,n-n/3,crc32c(p,n/3)));
+  }
+}
+
+void test_compression()
+{
+  using namespace boost::bloom::detail;
+
+  boost::uint64_t x=1;
+  auto rnd=[&]{
+    x=x*6364136223846793005ull+1442695040888963407ull;
+    return (std::size_t)(x>>33);
+  };
+
+  for(std::size_t n:{0,1,9,4096,4097,20000}){
+    for(double fill:{0.0,0.001,0.01,0.05,0.5}){
+      std::vector<unsigned char> a(n),b(n,0xFF),c(n),d(n);
+      for(std::size_t i=0;i<fill*n*8;++i){
+        auto pos=rnd()%(n*8);
+        a[pos/8]|=(unsigned char)(1u<<(pos%8));
+      }
+      for(auto& e:c)e=(unsigned char)(1u<<(rnd()%8));
+      for(std::size_t i=0;i<n;++i)d[i]=a[i]|c[i];
+
+      std::vector<unsigned char> out;
+      compress_array(a.data(),n,out);
+      BOOST_TEST_LE(out.size(),compression_max_size(n));
+      decompress_array<false>(out.data(),out.data()+out.size(),b.data(),n);
+      BOOST_TEST(a==b);
+      decompress_array<true>(out.data(),out.data()+out.size(),c.data(),n);
+      BOOST_TEST(c==d);
+
+      /* malformed data is either rejected or decoded within bounds */
+
+      for(int i=0;i<100&&!out.empty();++i){
+        auto out2=out;
+        out2[rnd()%out2.size()]^=(unsigned char)(1u<<(rnd()%8));
+        out2.resize(out2.size()-rnd()%2);
+        try{
+          decompress_array<false>(
+            out2.data(),out2.data()+out2.size(),b.data(),n);
+        }
+        catch(const std::runtime_error&){}
+      }
+    }
+  }
+}
+
+int main()
+{
+  test_crc32c();
+  test_compression();
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  test_interoperability();
+  return boost::report_errors();
+}
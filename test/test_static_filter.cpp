@@ -0,0 +1,138 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/static_filter.hpp>
+#include <boost/bloom/thread_executor.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+void test_static_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  std::vector<value_type> input;
+  value_factory<value_type> fac;
+  for(int i=0;i<200000;++i)input.push_back(fac());
+  auto mid=input.begin()+100000;
+
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0u);
+    BOOST_TEST(!f.may_contain(input[0]));
+    BOOST_TEST(f==filter(input.begin(),input.begin()));
+  }
+
+  boost::bloom::thread_executor ex(4);
+
+  for(std::size_t n:{1,2,3,10,100,1000,100000}){
+    filter f(input.begin(),input.begin()+n);
+    BOOST_TEST(may_contain(f,std::vector<value_type>(
+      input.begin(),input.begin()+n)));
+    BOOST_TEST_GT(f.capacity(),0u);
+
+    /* parallel construction produces the same filter */
+
+    BOOST_TEST(f==filter(ex,input.begin(),input.begin()+n));
+    BOOST_TEST(
+      f==filter(reverse_serial_executor{},input.begin(),input.begin()+n));
+
+    /* duplicates are ignored */
+
+    std::vector<value_type> dup(input.begin(),input.begin()+n);
+    dup.insert(dup.end(),input.begin(),input.begin()+n);
+    filter f2(dup.begin(),dup.end());
+    BOOST_TEST(may_contain(f2,dup));
+    BOOST_TEST(f2==filter(ex,dup.begin(),dup.end()));
+
+    /* bulk lookup */
+
+    std::vector<bool> res1,res2;
+    for(auto it=input.begin();it!=input.begin()+2*n;++it){
+      res1.push_back(f.may_contain(*it));
+    }
+    f.may_contain(input.begin(),input.begin()+2*n,std::back_inserter(res2));
+    BOOST_TEST(res1==res2);
+  }
+
+  {
+    /* FPR and space usage */
+
+    filter      f(input.begin(),mid);
+    std::size_t fp=0;
+    for(auto it=mid;it!=input.end();++it)fp+=f.may_contain(*it);
+    double expected_fp=filter::fpr()*(double)(input.end()-mid);
+    BOOST_TEST_LT((double)fp,expected_fp*1.5+10.0);
+    BOOST_TEST_LE(
+      f.capacity(),
+      (std::size_t)((double)(mid-input.begin())*filter::fingerprint_bits*1.2));
+  }
+
+  {
+    /* copy, move, swap */
+
+    filter f(input.begin(),mid);
+    filter f2(f);
+    BOOST_TEST(f2==f);
+    filter f3(std::move(f2));
+    BOOST_TEST(f3==f);
+    BOOST_TEST_EQ(f2.capacity(),0u);
+    BOOST_TEST(!f2.may_contain(input[0]));
+    f2=f3;
+    BOOST_TEST(f2==f);
+    filter f4(input.begin(),input.begin()+10);
+    swap(f4,f2);
+    BOOST_TEST(f4==f);
+    BOOST_TEST(f2!=f);
+    f2=std::move(f4);
+    BOOST_TEST(f2==f);
+    BOOST_TEST(f4!=f);
+  }
+}
+
+template<typename T,std::size_t F>
+using static_filter=boost::bloom::static_filter<T,F>;
+
+using test_types=boost::mp11::mp_list<
+  static_filter<int,8>,
+  static_filter<int,16>,
+  static_filter<std::string,8>,
+  static_filter<std::string,16>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_static_filter<typename T::type>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+
+  {
+    boost::bloom::static_filter<int> f{1,2,3,4,5};
+    for(int i=1;i<=5;++i)BOOST_TEST(f.may_contain(i));
+  }
+  return boost::report_errors();
+}
@@ -10,9 +10,11 @@
 #define BOOST_BLOOM_TEST_TEST_TYPES_HPP
 
 #include <boost/bloom/block.hpp>
+#include <boost/bloom/fast_block.hpp>
 #include <boost/bloom/fast_multiblock32.hpp>
 #include <boost/bloom/fast_multiblock64.hpp>
 #include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
 #include <boost/bloom/multiblock.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/mp11/algorithm.hpp>
@@ -35,6 +37,23 @@ using test_types=boost::mp11::mp_list<
   >,
   boost::bloom::filter<
     int,1,boost::bloom::fast_multiblock64<11>
+  >,
+  boost::bloom::filter<
+    std::size_t,1,boost::bloom::fast_block<7,512>,16
+  >,
+  boost::bloom::filter<
+    int,3,boost::bloom::block<unsigned char,1>,0,
+    boost::hash<int>,std::allocator<int>,boost::bloom::mask_and_remix
+  >,
+  boost::bloom::filter<
+    std::string,2,boost::bloom::multiblock<boost::uint32_t,4>,0,
+    boost::hash<std::string>,std::allocator<std::string>,
+    boost::bloom::fastrange32
+  >,
+  boost::bloom::filter<
+    std::size_t,4,boost::bloom::fast_multiblock32<3>,0,
+    boost::hash<std::size_t>,std::allocator<std::size_t>,
+    boost::bloom::double_hashing
   >
 >;
 
@@ -10,10 +10,13 @@
 #define BOOST_BLOOM_TEST_TEST_UTILITIES_HPP
 
 #include <boost/bloom/filter.hpp>
+#include <boost/bloom/hash_strategy.hpp>
 #include <boost/core/allocator_traits.hpp>
 #include <limits>
 #include <new>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace test_utilities{
 
@@ -40,11 +43,12 @@ struct revalue_filter_impl;
 
 template<
   typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
-  typename U
+  typename HS,typename U
 >
-struct revalue_filter_impl<boost::bloom::filter<T,K,S,B,H,A>,U>
+struct revalue_filter_impl<boost::bloom::filter<T,K,S,B,H,A,HS>,U>
 {
-  using type=boost::bloom::filter<U,K,S,B,H,boost::allocator_rebind_t<A,U>>;
+  using type=
+    boost::bloom::filter<U,K,S,B,H,boost::allocator_rebind_t<A,U>,HS>;
 };
 
 template<typename Filter,typename U>
@@ -55,11 +59,11 @@ struct rehash_filter_impl;
 
 template<
   typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
-  typename Hash
+  typename HS,typename Hash
 >
-struct rehash_filter_impl<boost::bloom::filter<T,K,S,B,H,A>,Hash>
+struct rehash_filter_impl<boost::bloom::filter<T,K,S,B,H,A,HS>,Hash>
 {
-  using type=boost::bloom::filter<T,K,S,B,Hash,A>;
+  using type=boost::bloom::filter<T,K,S,B,Hash,A,HS>;
 };
 
 template<typename Filter,typename Hash>
@@ -70,16 +74,37 @@ struct realloc_filter_impl;
 
 template<
   typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
-  typename Allocator
+  typename HS,typename Allocator
 >
-struct realloc_filter_impl<boost::bloom::filter<T,K,S,B,H,A>,Allocator>
+struct realloc_filter_impl<boost::bloom::filter<T,K,S,B,H,A,HS>,Allocator>
 {
-  using type=boost::bloom::filter<T,K,S,B,H,Allocator>;
+  using type=boost::bloom::filter<T,K,S,B,H,Allocator,HS>;
 };
 
 template<typename Filter,typename Allocator>
 using realloc_filter=typename realloc_filter_impl<Filter,Allocator>::type;
 
+/* exception thrown when a filter can't have the requested capacity:
+ * fastrange32 and double_hashing reject ranges greater than 2^32 before
+ * trying to allocate
+ */
+
+template<typename Filter>
+using capacity_error=typename std::conditional<
+  std::is_same<
+    typename Filter::hash_strategy,boost::bloom::fastrange32>::value||
+  std::is_same<
+    typename Filter::hash_strategy,boost::bloom::double_hashing>::value,
+  std::length_error,
+  std::bad_alloc
+>::type;
+
+/* mask_and_remix may double the requested capacity */
+
+template<typename Filter>
+using pow2_capacity=std::is_same<
+  typename Filter::hash_strategy,boost::bloom::mask_and_remix>;
+
 void* capped_new(std::size_t n)
 {
   using limits=std::numeric_limits<std::size_t>;
@@ -95,6 +120,19 @@ void* capped_new(std::size_t n)
   return ::operator new(n);
 }
 
+/* runs invocations in reverse order to make sure results don't depend on
+ * the order of execution
+ */
+
+struct reverse_serial_executor
+{
+  template<typename F>
+  void operator()(std::size_t n,F f)const
+  {
+    while(n--)f(n);
+  }
+};
+
 template<typename Filter,typename Input>
 bool may_contain(const Filter& f,const Input& input)
 {